@@ -0,0 +1,110 @@
+#include <Hydrogen/Assets/AssetDependencyGraph.hpp>
+#include <Hydrogen/Assets/AssetManager.hpp>
+#include <Hydrogen/Assets/AssetPack.hpp>
+#include <Hydrogen/Core/Cache.hpp>
+#include <Hydrogen/Core/JobSystem.hpp>
+#include <Hydrogen/Core/Logger.hpp>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+using namespace Hydrogen;
+
+// Filesystems with coarse timestamps round the modification time down, artifacts touched right after the start must still count
+static constexpr auto s_TimestampTolerance = std::chrono::seconds(2);
+
+static void PrintUsage() {
+  std::cout << "Usage: hydrogen-cook [options]\n"
+               "  --root <dir>     Working directory the asset and cache paths are relative to\n"
+               "  --assets <dir>   Asset directory to cook (default: assets)\n"
+               "  --cache <dir>    Cache directory the cooked artifacts are written to (default: cache)\n"
+               "  --pack <file>    Additionally write the assets and their cooked artifacts into a .hypak pack\n"
+               "  --threads <n>    Number of worker threads (default: one per hardware thread)\n"
+               "  --no-compress    Store the pack entries uncompressed\n";
+}
+
+int main(int argc, char** argv) {
+  std::filesystem::path assetDirectory = "assets";
+  std::filesystem::path cacheDirectory = CacheFile::GetDirectory();
+  std::filesystem::path packFilepath;
+  uint32_t threadCount = 0;
+  bool compress = true;
+
+  for (int i = 1; i < argc; i++) {
+    String argument = argv[i];
+    bool hasValue = i + 1 < argc;
+
+    if (argument == "--root" && hasValue) {
+      std::error_code error;
+      std::filesystem::current_path(argv[++i], error);
+      if (error) {
+        std::cerr << "Can not use " << argv[i] << " as the root directory: " << error.message() << "\n";
+        return 1;
+      }
+    } else if (argument == "--assets" && hasValue) {
+      assetDirectory = argv[++i];
+    } else if (argument == "--cache" && hasValue) {
+      cacheDirectory = argv[++i];
+    } else if (argument == "--pack" && hasValue) {
+      packFilepath = argv[++i];
+    } else if (argument == "--threads" && hasValue) {
+      try {
+        size_t end = 0;
+        String value = argv[++i];
+        auto count = std::stoul(value, &end);
+        if (end != value.size() || count > std::numeric_limits<uint32_t>::max()) throw std::out_of_range(value);
+        threadCount = static_cast<uint32_t>(count);
+      } catch (const std::exception&) {
+        PrintUsage();
+        return 1;
+      }
+    } else if (argument == "--no-compress") {
+      compress = false;
+    } else {
+      PrintUsage();
+      return argument == "--help" ? 0 : 1;
+    }
+  }
+
+  SystemLogger::Init();
+
+  std::error_code error;
+  if (!std::filesystem::is_directory(assetDirectory, error)) {
+    HY_LOG_ERROR("Asset directory {} does not exist!", assetDirectory.string());
+    return 1;
+  }
+
+  auto startTime = std::filesystem::file_time_type::clock::now();
+
+  CacheFile::SetDirectory(cacheDirectory);
+  JobSystem::Init(threadCount);
+  bool cooked = AssetManager::Cook(assetDirectory);
+  JobSystem::Shutdown();
+
+  // A pack missing artifacts would silently fall back to importing at runtime
+  if (!cooked) return 1;
+  if (packFilepath.empty()) return 0;
+
+  // The sources are packed too, the runtime hashes them to find the matching artifacts
+  AssetPackWriter writer;
+  writer.SetCompression(compress);
+  writer.AddDirectory(assetDirectory);
+
+  // Loading touches every artifact it reads or writes, so anything older belongs to stale sources and stays out of the pack
+  uint32_t artifactCount = 0;
+  for (const auto& dirEntry : std::filesystem::recursive_directory_iterator(cacheDirectory, error)) {
+    if (!dirEntry.is_regular_file(error) || dirEntry.path().extension() == ".tmp") continue;
+    if (dirEntry.path() != AssetDependencyGraph::GetFilepath() && dirEntry.last_write_time(error) + s_TimestampTolerance < startTime) continue;
+
+    writer.AddFile(std::filesystem::path(CacheFile::s_PackDirectory) / std::filesystem::relative(dirEntry.path(), cacheDirectory), dirEntry.path());
+    artifactCount++;
+  }
+
+  if (!writer.Write(packFilepath)) return 1;
+
+  HY_LOG_INFO("Wrote {} cooked artifacts to {}", artifactCount, packFilepath.string());
+  return 0;
+}
@@ -7,7 +7,8 @@ layout(binding = 0) uniform UniformBufferObject {
 } ubo;
 
 layout(location = 0) in vec3 inPosition;
-layout(location = 1) in vec3 inNormal;
+// Octahedral encoded with the quantized mesh vertex format, see MeshOptimizer::EncodeOctahedral
+layout(location = 1) in vec2 inNormal;
 layout(location = 2) in vec2 inTexCoords;
 
 layout(location = 0) out vec2 fragTexCoords;
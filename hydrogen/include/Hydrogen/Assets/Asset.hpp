@@ -1,21 +1,125 @@
 #pragma once
 
 #include "../Core/Memory.hpp"
+#include "../Core/JobSystem.hpp"
+#include <atomic>
 #include <filesystem>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <type_traits>
 
 namespace Hydrogen {
+// Interned asset path, see AssetManager::GetAssetID. IDs are dense and stay valid for the lifetime of the process
+using AssetID = uint32_t;
+static constexpr AssetID InvalidAssetID = 0;
+
+enum class AssetType : uint8_t { Unknown = 0, Sprite, Shader, Mesh, Count };
+
 class Asset {
  public:
   struct AssetInfo {
     bool Preload;
   };
 
-  virtual ~Asset() = default;
-  virtual void Load(const std::filesystem::path& filepath) = 0;
+  enum class AssetState { Unloaded = 0, Loading = 1, Loaded = 2, Failed = 3 };
+
+  // Accumulated over every load of this instance, the asset manager fills in the load side, assets report their GPU uploads
+  struct LoadStats {
+    uint64_t ReadBytes = 0;
+    double IOMilliseconds = 0.0;
+    double DecodeMilliseconds = 0.0;
+    double UploadMilliseconds = 0.0;
+    size_t GPUBytes = 0;
+    uint32_t LoadCount = 0;
+  };
+
+  virtual ~Asset() {
+    SetResident(false);
+    s_GPUBytes.fetch_sub(m_Stats.GPUBytes, std::memory_order_relaxed);
+  }
+  virtual AssetType GetType() const = 0;
+  // Returns false if the file could not be read, decoded or compiled. The asset logs the reason, the asset manager discards what was loaded
+  virtual bool Load(const std::filesystem::path& filepath) = 0;
+  // Frees the CPU-side data, the asset manager loads it again on the next request
+  virtual void Unload() {}
+  virtual size_t GetMemoryUsage() const { return 0; }
 
   AssetInfo GetInfo() { return m_AssetInfo; }
+  AssetState GetState() const { return m_State.load(std::memory_order_acquire); }
+  bool IsLoaded() const { return GetState() == AssetState::Loaded; }
+  bool HasFailed() const { return GetState() == AssetState::Failed; }
+
+  LoadStats GetLoadStats() const {
+    std::lock_guard<std::mutex> lock(m_StatsMutex);
+    return m_Stats;
+  }
+
+  // The callback runs on the main thread at the next frame boundary after the asset finished loading, also if the load failed (see HasFailed)
+  void OnLoaded(const std::function<void()>& callback) {
+    std::lock_guard<std::mutex> lock(m_LoadMutex);
+    if (IsLoaded() || HasFailed()) {
+      JobSystem::ExecuteOnMainThread(callback);
+    } else {
+      m_LoadCallbacks.push_back(callback);
+    }
+  }
 
  protected:
+  // For assets that hand their data over to the GPU and drop the CPU copy themselves
+  void MarkUnloaded() {
+    std::lock_guard<std::mutex> lock(m_LoadMutex);
+    SetResident(false);
+    m_State.store(AssetState::Unloaded, std::memory_order_release);
+    m_LoadFuture = std::shared_future<void>();
+  }
+
+  // GPU bytes are the size of the resources currently created from this asset, the upload time is accumulated
+  void RecordUpload(size_t gpuBytes, double milliseconds) {
+    std::lock_guard<std::mutex> lock(m_StatsMutex);
+    s_GPUBytes.fetch_add(gpuBytes, std::memory_order_relaxed);
+    s_GPUBytes.fetch_sub(m_Stats.GPUBytes, std::memory_order_relaxed);
+    m_Stats.GPUBytes = gpuBytes;
+    m_Stats.UploadMilliseconds += milliseconds;
+  }
+
   AssetInfo m_AssetInfo;
+
+ private:
+  // Called with the load mutex held whenever the asset enters or leaves the loaded state, so the totals never need a sweep over all assets
+  void SetResident(bool resident) {
+    auto bytes = resident ? GetMemoryUsage() : 0;
+    s_ResidentBytes.fetch_add(bytes, std::memory_order_relaxed);
+    s_ResidentBytes.fetch_sub(m_ResidentBytes, std::memory_order_relaxed);
+    if (resident != m_Resident) s_ResidentCount.fetch_add(resident ? 1 : -1, std::memory_order_relaxed);
+    m_ResidentBytes = bytes;
+    m_Resident = resident;
+  }
+
+  std::atomic<AssetState> m_State = AssetState::Unloaded;
+  std::atomic<uint64_t> m_LastAccess = 0;
+  std::shared_future<void> m_LoadFuture;
+  DynamicArray<std::function<void()>> m_LoadCallbacks;
+  std::mutex m_LoadMutex;
+  LoadStats m_Stats;
+  mutable std::mutex m_StatsMutex;
+  // CPU bytes counted into s_ResidentBytes, the memory usage at the end of the last load
+  size_t m_ResidentBytes = 0;
+  bool m_Resident = false;
+
+  // Totals over all instances, read by the asset manager for its budget and profiling
+  static inline std::atomic<size_t> s_ResidentBytes = 0;
+  static inline std::atomic<int64_t> s_ResidentCount = 0;
+  static inline std::atomic<size_t> s_GPUBytes = 0;
+
+  friend class AssetManager;
 };
+
+// Checks the type tag instead of using RTTI, every asset class provides a static GetStaticType()
+template <typename T>
+ReferencePointer<T> AssetCast(const ReferencePointer<Asset>& asset) {
+  static_assert(std::is_base_of<Asset, T>::value, "T must be derived from Asset");
+  if (!asset || asset->GetType() != T::GetStaticType()) return nullptr;
+  return std::static_pointer_cast<T>(asset);
+}
 }  // namespace Hydrogen
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include "../Core/Memory.hpp"
+
+namespace Hydrogen {
+// Records which source files every imported asset was built from (shader stages and includes, material libraries, textures, ...).
+// The graph is persisted in the metadata directory of the cache, so invalidation also works across runs
+class AssetDependencyGraph {
+ public:
+  static void Load();
+  // Only writes if the graph changed since the last save
+  static void Save();
+
+  // Replaces all recorded dependencies of the asset, called by the importers
+  static void SetDependencies(const std::filesystem::path& asset, const DynamicArray<std::filesystem::path>& dependencies);
+  static DynamicArray<std::filesystem::path> GetDependencies(const std::filesystem::path& asset);
+  static DynamicArray<std::filesystem::path> GetDependents(const std::filesystem::path& filepath);
+  // Every asset that has to be rebuilt if the file changes, in breadth first order and without the file itself
+  static DynamicArray<std::filesystem::path> CollectDependents(const std::filesystem::path& filepath);
+
+  static bool IsDirty();
+  static std::filesystem::path GetFilepath();
+
+ private:
+  static UnorderedMap<String, DynamicArray<String>> s_Dependencies;
+  static UnorderedMap<String, DynamicArray<String>> s_Dependents;
+  static bool s_Dirty;
+  static std::mutex s_Mutex;
+};
+}  // namespace Hydrogen
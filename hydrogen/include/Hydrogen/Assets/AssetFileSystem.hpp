@@ -0,0 +1,43 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <shared_mutex>
+#include "../Core/Memory.hpp"
+#include "AssetPack.hpp"
+
+namespace Hydrogen {
+// Resolves asset paths through the mounted packs first (most recently mounted wins) and falls back to loose files on disk
+class AssetFileSystem {
+ public:
+  struct ReadStats {
+    uint64_t Bytes = 0;
+    uint64_t Nanoseconds = 0;
+  };
+
+  static bool Mount(const std::filesystem::path& packFilepath);
+  static void UnmountAll();
+  static bool HasPacks();
+
+  static bool Exists(const std::filesystem::path& filepath);
+  static bool IsDirectory(const std::filesystem::path& filepath);
+  // Uncompressed size, 0 if the file does not exist
+  static uintmax_t GetFileSize(const std::filesystem::path& filepath);
+  static std::optional<DynamicArray<char>> ReadFile(const std::filesystem::path& filepath);
+  // Files stored directly below the directory, merged across packs and disk
+  static DynamicArray<std::filesystem::path> ListDirectory(const std::filesystem::path& directory);
+  // Every file below the directory, recursively
+  static DynamicArray<std::filesystem::path> ListFiles(const std::filesystem::path& directory);
+
+  // Running totals of the calling thread, the difference around a load is the I/O of that asset
+  static ReadStats GetThreadReadStats();
+  static void AddThreadReadStats(uint64_t bytes, uint64_t nanoseconds);
+
+ private:
+  static std::optional<DynamicArray<char>> ReadFileUntracked(const std::filesystem::path& filepath);
+
+  static DynamicArray<ScopePointer<AssetPack>> s_Packs;
+  static std::shared_mutex s_PacksMutex;
+  static thread_local ReadStats s_ThreadReadStats;
+};
+}  // namespace Hydrogen
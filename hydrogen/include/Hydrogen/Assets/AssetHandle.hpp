@@ -0,0 +1,39 @@
+#pragma once
+
+#include <functional>
+#include <future>
+#include "../Core/JobSystem.hpp"
+#include "../Core/Memory.hpp"
+#include "Asset.hpp"
+
+namespace Hydrogen {
+template <typename T>
+class AssetHandle {
+ public:
+  AssetHandle() = default;
+  AssetHandle(const ReferencePointer<T>& asset, const std::shared_future<void>& loadFuture) : m_Asset(asset), m_LoadFuture(loadFuture) {}
+
+  bool IsValid() const { return m_Asset != nullptr; }
+  bool IsReady() const { return m_Asset && m_Asset->IsLoaded(); }
+
+  // Returns nullptr while the asset is still loading, so callers can keep using a placeholder
+  ReferencePointer<T> Get() const { return IsReady() ? m_Asset : nullptr; }
+
+  const ReferencePointer<T>& Wait() const {
+    JobSystem::Wait(m_LoadFuture);
+    return m_Asset;
+  }
+
+  // Not called if the load fails
+  void OnReady(const std::function<void(const ReferencePointer<T>&)>& callback) const {
+    if (!m_Asset) return;
+    m_Asset->OnLoaded([asset = m_Asset, callback]() {
+      if (!asset->HasFailed()) callback(asset);
+    });
+  }
+
+ private:
+  ReferencePointer<T> m_Asset;
+  std::shared_future<void> m_LoadFuture;
+};
+}  // namespace Hydrogen
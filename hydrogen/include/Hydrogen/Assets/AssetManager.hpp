@@ -1,46 +1,163 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <filesystem>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 #include "../Core/Memory.hpp"
+#include "../Core/FileWatcher.hpp"
+#include "../Core/JobSystem.hpp"
+#include "AssetHandle.hpp"
 #include "ShaderAsset.hpp"
 #include "SpriteAsset.hpp"
 #include "MeshAsset.hpp"
 
 namespace Hydrogen {
+struct AssetStats {
+  AssetID ID;
+  String Filepath;
+  AssetType Type;
+  Asset::AssetState State;
+  // Sources and cooked artifacts read while loading
+  uint64_t ReadBytes;
+  size_t CPUBytes;
+  size_t GPUBytes;
+  double IOMilliseconds;
+  double DecodeMilliseconds;
+  double UploadMilliseconds;
+  uint32_t LoadCount;
+  // References held outside of the asset manager
+  long ReferenceCount;
+};
+
 class AssetManager {
  public:
+  using ReloadCallback = std::function<void(const ReferencePointer<class Asset>&)>;
+
   static void Init();
+  // Loads every asset below the directory in parallel without a renderer, so the importers write their cooked artifacts into the cache.
+  // Returns false if any asset failed to load
+  static bool Cook(const std::filesystem::path& directory);
+  // Called once per frame on the main thread, picks up changed asset files and starts reloading them on the job system
+  static void Update();
+
+  // Interns the path, lookups by ID skip hashing and normalizing the path. Hot paths should resolve the ID once and keep it
+  static AssetID GetAssetID(const std::filesystem::path& filepath);
+  static String GetAssetPath(AssetID id);
+
+  // Loads the asset on the calling thread, or waits for an asynchronous load that is already in flight.
+  // Returns nullptr if the file does not exist, holds a different asset type or failed to load
+  template <typename T>
+  static ReferencePointer<T> Get(AssetID id) {
+    static_assert(std::is_base_of<class Asset, T>::value, "T must be derived from Asset");
+
+    auto asset = FindOrCreateAsset(id, T::GetStaticType());
+    if (!asset) return nullptr;
+
+    JobSystem::Wait(RequestLoad(asset, id, false));
+    if (asset->HasFailed()) return nullptr;
+    return std::static_pointer_cast<T>(asset);
+  }
 
   template <typename T>
   static ReferencePointer<T> Get(const std::filesystem::path& filename) {
+    return Get<T>(GetAssetID(filename));
+  }
+
+  // File I/O and decoding run on the job system, the returned handle can be polled, waited on or given a completion callback
+  template <typename T>
+  static AssetHandle<T> LoadAsync(AssetID id) {
     static_assert(std::is_base_of<class Asset, T>::value, "T must be derived from Asset");
 
-    if (s_Assets.count(filename)) return std::dynamic_pointer_cast<T>(s_Assets[filename]);
-
-    std::filesystem::path filepath(filename);
-    if (!(std::filesystem::exists(filepath))) {
-      return std::dynamic_pointer_cast<T>(s_Assets[filename]);
-    }
-
-    auto extension = filepath.extension().string();
-    if (SpriteAsset::CheckFileExtensions(extension)) {
-      auto ref = NewReferencePointer<SpriteAsset>();
-      ref->Load(filename);
-      s_Assets[filename] = ref;
-    } else if (ShaderAsset::CheckFileExtensions(extension)) {
-      auto ref = NewReferencePointer<ShaderAsset>();
-      ref->Load(filename);
-      s_Assets[filename] = ref;
-    } else if (MeshAsset::CheckFileExtensions(extension)) {
-      auto ref = NewReferencePointer<MeshAsset>();
-      ref->Load(filename);
-      s_Assets[filename] = ref;
-    }
-
-    return std::dynamic_pointer_cast<T>(s_Assets[filename]);
+    auto asset = FindOrCreateAsset(id, T::GetStaticType());
+    if (!asset) return AssetHandle<T>();
+
+    auto loadFuture = RequestLoad(asset, id, true);
+    return AssetHandle<T>(std::static_pointer_cast<T>(asset), loadFuture);
   }
 
+  template <typename T>
+  static AssetHandle<T> LoadAsync(const std::filesystem::path& filename) {
+    return LoadAsync<T>(GetAssetID(filename));
+  }
+
+  // Every registered asset of the type, whether it is loaded or not
+  static DynamicArray<AssetID> GetAssetIDs(AssetType type);
+
+  // Assets that are only referenced by the asset manager are unloaded in least recently used order by Update once the budget is exceeded
+  static void SetMemoryBudget(size_t bytes) { s_MemoryBudget = bytes; }
+  static size_t GetMemoryBudget() { return s_MemoryBudget; }
+  // CPU bytes of the loaded assets, kept up to date on every load and unload
+  static size_t GetMemoryUsage();
+  // Does nothing while the usage is within the budget. Returns the number of bytes freed
+  static size_t CollectGarbage();
+
+  // One entry per registered asset, the load times are accumulated over reloads and reloads after eviction
+  static DynamicArray<AssetStats> GetStats();
+  // Writes GetStats() as JSON, e.g. to diff content between builds or to feed budget tooling
+  static bool DumpStats(const std::filesystem::path& filepath);
+
+  // Enabled by default in non-release builds, takes effect on the next Init
+  static void SetHotReload(bool enabled) { s_HotReload = enabled; }
+  // The callback runs on the main thread at a frame boundary, after the reloaded asset replaced the old one
+  static uint64_t AddReloadCallback(const std::filesystem::path& filepath, const ReloadCallback& callback);
+  static void RemoveReloadCallback(uint64_t id);
+
  private:
-  static std::unordered_map<std::filesystem::path, ReferencePointer<Asset>> s_Assets;
+  struct AssetSlot {
+    String Filepath;
+    // Guarded by the lock of the shard the ID belongs to
+    ReferencePointer<Asset> Instance;
+  };
+
+  struct PathShard {
+    std::shared_mutex Mutex;
+    std::unordered_map<String, AssetID> IDs;
+  };
+
+  struct ReloadListener {
+    AssetID ID;
+    ReloadCallback Callback;
+  };
+
+  static ReferencePointer<Asset> CreateAsset(const std::filesystem::path& filepath);
+  // Only the slot memory is looked up here, the caller has to hold the shard lock to touch the instance
+  static AssetSlot& GetSlot(AssetID id) { return s_SlotChunks[id / s_SlotChunkSize].load(std::memory_order_acquire)[id % s_SlotChunkSize]; }
+  static std::shared_mutex& GetSlotMutex(AssetID id) { return s_SlotMutexes[id % s_ShardCount]; }
+  static ReferencePointer<Asset> FindAsset(AssetID id);
+  static ReferencePointer<Asset> FindOrCreateAsset(AssetID id, AssetType type);
+  static std::shared_future<void> RequestLoad(const ReferencePointer<Asset>& asset, AssetID id, bool async);
+  static void Reload(AssetID id);
+
+  // Mounted automatically by Init if it exists in the working directory
+  static constexpr const char* s_DefaultPack = "assets.hypak";
+
+  // Slots live in fixed size chunks that are never moved, so readers only need the lock of their shard and never a global one
+  static constexpr uint32_t s_ShardCount = 16;
+  static constexpr uint32_t s_SlotChunkSize = 1024;
+  static constexpr uint32_t s_MaxSlotChunks = 1024;
+
+  static std::array<PathShard, s_ShardCount> s_PathShards;
+  static std::array<std::shared_mutex, s_ShardCount> s_SlotMutexes;
+  static std::array<std::atomic<AssetSlot*>, s_MaxSlotChunks> s_SlotChunks;
+  static DynamicArray<ScopePointer<AssetSlot[]>> s_SlotChunkStorage;
+  static std::mutex s_SlotChunkMutex;
+  static std::atomic<AssetID> s_NextAssetID;
+  static std::array<DynamicArray<AssetID>, static_cast<size_t>(AssetType::Count)> s_TypeAssets;
+  static std::mutex s_TypeAssetsMutex;
+
+  static std::atomic<uint64_t> s_AccessCounter;
+  static size_t s_MemoryBudget;
+
+  // Hot reload state is only touched on the main thread
+  static bool s_HotReload;
+  static ScopePointer<FileWatcher> s_Watcher;
+  static UnorderedMap<uint64_t, ReloadListener> s_ReloadListeners;
+  static uint64_t s_NextReloadListener;
+  static UnorderedMap<AssetID, uint64_t> s_ReloadGenerations;
 };
 }  // namespace Hydrogen
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include "../Core/Base.hpp"
+#include "../Core/Memory.hpp"
+#include "../Core/MappedFile.hpp"
+
+namespace Hydrogen {
+// Layout of a .hypak archive, all integers are little endian:
+//   PackHeader | payloads, each aligned to s_PackAlignment | PackEntry[EntryCount] sorted by (PathHash, path) | path string table
+struct PackHeader {
+  char Magic[4];
+  uint32_t Version;
+  uint32_t EntryCount;
+  uint32_t Reserved;
+  uint64_t TableOffset;
+  uint64_t StringsOffset;
+  uint64_t StringsSize;
+};
+
+enum PackEntryFlags : uint32_t { PackEntryFlags_None = 0, PackEntryFlags_Compressed = BIT(0) };
+
+struct PackEntry {
+  uint64_t PathHash;
+  uint64_t Offset;
+  uint64_t Size;
+  uint64_t StoredSize;
+  uint32_t PathOffset;
+  uint32_t PathLength;
+  uint32_t Flags;
+  uint32_t Reserved;
+};
+
+static_assert(sizeof(PackHeader) == 40, "PackHeader must not contain padding");
+static_assert(sizeof(PackEntry) == 48, "PackEntry must not contain padding");
+
+class AssetPack {
+ public:
+  static constexpr char s_Magic[4] = {'H', 'Y', 'P', 'K'};
+  static constexpr uint32_t s_Version = 1;
+  static constexpr uint64_t s_Alignment = 4096;
+
+  // Paths are stored in normalized generic form, so lookups are independent of the platform separator
+  static String NormalizePath(const std::filesystem::path& filepath);
+  static uint64_t HashPath(const String& path);
+
+  AssetPack(const std::filesystem::path& filepath);
+
+  bool IsValid() const { return m_Entries != nullptr; }
+  const std::filesystem::path& GetFilepath() const { return m_File.GetFilepath(); }
+
+  // The table of contents is read in place from the mapping, lookups are a binary search over the path hashes
+  const PackEntry* Find(const std::filesystem::path& filepath) const;
+  bool Exists(const std::filesystem::path& filepath) const { return Find(filepath) != nullptr; }
+  // Packs only store files, a directory exists if any file is stored below it
+  bool IsDirectory(const std::filesystem::path& directory) const;
+  std::optional<DynamicArray<char>> Read(const std::filesystem::path& filepath) const;
+  // Direct view into the mapping for entries that are stored uncompressed, nullptr otherwise
+  const uint8_t* GetData(const PackEntry& entry) const;
+
+  // Files (not subdirectories) stored directly below the directory
+  DynamicArray<std::filesystem::path> ListDirectory(const std::filesystem::path& directory) const;
+  DynamicArray<std::filesystem::path> ListFiles() const;
+
+  uint32_t GetEntryCount() const { return m_EntryCount; }
+  const PackEntry& GetEntry(uint32_t index) const { return m_Entries[index]; }
+  String GetEntryPath(const PackEntry& entry) const { return String(m_Strings + entry.PathOffset, entry.PathLength); }
+
+ private:
+  MappedFile m_File;
+  const PackEntry* m_Entries = nullptr;
+  uint32_t m_EntryCount = 0;
+  const char* m_Strings = nullptr;
+  DynamicArray<uint64_t> m_DirectoryHashes;
+};
+
+class AssetPackWriter {
+ public:
+  // Entries are only compressed if that saves at least an eighth of their size
+  void SetCompression(bool compress) { m_Compress = compress; }
+
+  void AddFile(const std::filesystem::path& packPath, const std::filesystem::path& filepath);
+  // Adds every regular file below the directory, packed under the same relative path as on disk
+  void AddDirectory(const std::filesystem::path& directory);
+
+  bool Write(const std::filesystem::path& filepath);
+
+ private:
+  struct PendingFile {
+    String PackPath;
+    std::filesystem::path Filepath;
+  };
+
+  DynamicArray<PendingFile> m_Files;
+  bool m_Compress = true;
+};
+}  // namespace Hydrogen
@@ -1,46 +1,71 @@
 #pragma once
 
-#include <assimp/Importer.hpp>
-#include <assimp/scene.h>
-#include <assimp/postprocess.h>
+#include <assimp/vector3.h>
+#include <algorithm>
+#include <filesystem>
+#include <memory>
 
-#include "../Core/Assert.hpp"
-#include "../Core/Logger.hpp"
-#include "../Renderer/Texture.hpp"
+#include "../Core/Cache.hpp"
+#include "../Core/Memory.hpp"
 #include "../Renderer/Buffer.hpp"
+#include "../Renderer/GeometryBuffer.hpp"
+#include "../Renderer/MeshStreaming.hpp"
 #include "../Renderer/VertexArray.hpp"
 #include "../Scene/Scene.hpp"
 #include "../Scene/Entity.hpp"
 #include "../Scene/Components.hpp"
 #include "Asset.hpp"
+#include "MeshImportSettings.hpp"
+#include "MeshOptimizer.hpp"
+
+struct aiMesh;
+struct aiNode;
 
 namespace Hydrogen {
-class MeshAsset : public Asset {
+// Float vertices are 32 bytes (Float3 position, Float3 normal, Float2 texture coordinates). Quantized vertices are 16 bytes: Half4 position,
+// octahedral encoded Short2 normal (see MeshOptimizer::EncodeOctahedral) and Half2 texture coordinates
+enum class MeshVertexFormat : uint32_t { Float = 0, Quantized = 1 };
+
+// Every level targets Reduction times the triangles of the previous one, the chain ends early once a level would exceed MaxError (relative to the
+// bounding sphere radius of the submesh) or the simplifier can not remove enough triangles anymore
+struct MeshLODSettings {
+  uint32_t MaxLevels = 4;
+  float Reduction = 0.5f;
+  float MaxError = 0.05f;
+  // Weights of the normal and texture coordinate differences against the position error, higher values preserve shading and texture seams better
+  float NormalWeight = 0.5f;
+  float TexCoordWeight = 1.0f;
+};
+
+class MeshAsset : public Asset, public std::enable_shared_from_this<MeshAsset> {
  public:
-  MeshAsset() {
-    m_AssetInfo.Preload = true;
-    m_Scene = nullptr;
-  }
+  MeshAsset() { m_AssetInfo.Preload = false; }
 
-  void Load(const std::filesystem::path& filepath) override {
-    HY_ASSERT(!filepath.empty(),
-              "Parameter 'filepath' of type 'const String&' in function "
-              "MeshAsset::Load(const String& filepath) is an empty string!");
-    HY_LOG_INFO("Loading mesh asset '{}'!", filepath.string());
-    // TODO: Load asset here
-    m_Filepath = filepath;
-    HY_LOG_INFO("Finished loading mesh asset '{}'!", filepath.string());
-  }
+  static constexpr AssetType GetStaticType() { return AssetType::Mesh; }
+  AssetType GetType() const override { return GetStaticType(); }
+
+  // Has to be set before the first mesh is loaded and before the shaders drawing meshes are created, the cooked artifacts of each format are kept apart
+  static void SetVertexFormat(MeshVertexFormat format) { s_VertexFormat = format; }
+  static MeshVertexFormat GetVertexFormat() { return s_VertexFormat; }
+
+  // Has to be set before the meshes are loaded, changing it invalidates their cooked artifacts
+  static void SetLODSettings(const MeshLODSettings& settings) { s_LODSettings = settings; }
+  static const MeshLODSettings& GetLODSettings() { return s_LODSettings; }
+
+  static BufferLayout GetVertexLayout();
+
+  // Only touches the CPU, so it is safe to run on a worker thread, GPU buffers are created by Spawn on the main thread
+  bool Load(const std::filesystem::path& filepath) override;
+
+  // Streamed spawns only upload the coarsest level of the submeshes with levels of detail, MeshStreaming loads the finer ones once an instance needs
+  // them. The geometry is shared by all spawns of the same kind
+  void Spawn(const ScopePointer<Scene>& scene, const String& name, bool streamed = false);
+
+  // Spawned entities keep their own references to the vertex arrays, streamed meshes keep the asset loaded as long as they exist
+  void Unload() override;
+
+  size_t GetMemoryUsage() const override;
 
-  void Spawn(const ReferencePointer<class RenderDevice>& renderDevice, const ScopePointer<Scene>& scene, const String& name) {
-    //HY_ASSERT(m_Scene, "MeshAsset not yet loaded!");
-    Assimp::Importer importer;
-    m_Scene = importer.ReadFile(m_Filepath.string(), aiProcess_CalcTangentSpace | aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_SortByPType);
-    HY_ASSERT((m_Scene && !(m_Scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) && m_Scene->mRootNode), "Failed to load mesh file {}", m_Filepath.string());
-    HandleNode(renderDevice, m_Scene->mRootNode, name, scene, Entity());
-    importer.FreeScene();
-  }
-   
   static const DynamicArray<String> GetFileExtensions() { return DynamicArray<String>{".obj"}; }
 
   static bool CheckFileExtensions(const String& ext) {
@@ -49,65 +74,134 @@ class MeshAsset : public Asset {
   }
 
  private:
-  void HandleNode(const ReferencePointer<class RenderDevice>& renderDevice, aiNode* node, const String& name, const ScopePointer<Scene>& scene,
-                  Entity parent) {
-    Entity entity;
-
-    if (parent.GetEntityHandle() != entt::null) {
-      entity = parent.CreateChild(node->mName.C_Str());
-    } else {
-      entity = scene->CreateEntity(name);
-    }
-
-    auto& meshRenderer = entity.AddComponent<MeshRendererComponent>();
-
-    for (uint32_t i = 0; i < node->mNumMeshes; i++) {
-      aiVector3D* vertices = m_Scene->mMeshes[node->mMeshes[i]]->mVertices;
-      aiVector3D* normals = m_Scene->mMeshes[node->mMeshes[i]]->mNormals;
-      aiVector3D** texCoords = m_Scene->mMeshes[node->mMeshes[i]]->mTextureCoords;
-
-      DynamicArray<float> vertexData;
-      for (uint32_t j = 0; j < m_Scene->mMeshes[node->mMeshes[i]]->mNumVertices; j++) {
-        vertexData.push_back(vertices[j].x);
-        vertexData.push_back(vertices[j].y);
-        vertexData.push_back(vertices[j].z);
-
-        vertexData.push_back(normals[j].x);
-        vertexData.push_back(normals[j].y);
-        vertexData.push_back(normals[j].z);
-
-        vertexData.push_back(texCoords[0][j].x);
-        vertexData.push_back(texCoords[0][j].y);
-      }
-
-      DynamicArray<uint32_t> indexData;
-      for (uint32_t j = 0; j < m_Scene->mMeshes[node->mMeshes[i]]->mNumFaces; j++) {
-        aiFace face = m_Scene->mMeshes[node->mMeshes[i]]->mFaces[j];
-        for (uint32_t k = 0; k < face.mNumIndices; k++) {
-          indexData.push_back(face.mIndices[k]);
-        }
-      }
-
-      auto vertexBuffer = VertexBuffer::Create(renderDevice, vertexData.data(), vertexData.size() * sizeof(float));
-      vertexBuffer->SetLayout({{ShaderDataType::Float3, "Position", false}, {ShaderDataType::Float3, "Normal", false}, {ShaderDataType::Float2, "TexCoords", false}});
-      auto indexBuffer = IndexBuffer::Create(renderDevice, indexData.data(), indexData.size() * sizeof(uint32_t));
-      auto vertexArray = VertexArray::Create();
-      vertexArray->AddVertexBuffer(vertexBuffer);
-      vertexArray->SetIndexBuffer(indexBuffer);
-
-      meshRenderer.VertexArrays.push_back(vertexArray);
-    }
-
-    if (node->mNumMeshes <= 0) {
-      entity.RemoveComponent<MeshRendererComponent>();
-    }
-
-    for (uint32_t i = 0; i < node->mNumChildren; i++) {
-      HandleNode(renderDevice, node->mChildren[i], name, scene, entity);
-    }
-  }
+  struct SubMesh {
+    // Packed in the vertex format
+    DynamicArray<uint8_t> Vertices;
+    uint32_t VertexCount = 0;
+    // The indices of all levels of detail, one after the other
+    DynamicArray<uint32_t> Indices;
+    DynamicArray<MeshRendererComponent::LevelOfDetail> Levels;
+    // Clusters of the full resolution level, each one a contiguous range of its indices
+    DynamicArray<Meshlet> Meshlets;
+    glm::vec3 BoundsMin = glm::vec3(0.0f);
+    glm::vec3 BoundsMax = glm::vec3(0.0f);
+    // Centered on the box, which is close to the minimal sphere for typical meshes and far cheaper to find
+    glm::vec3 BoundsCenter = glm::vec3(0.0f);
+    float BoundsRadius = 0.0f;
+  };
+
+  // Flattened copy of the assimp node hierarchy, the root node is at index 0
+  struct Node {
+    String Name;
+    DynamicArray<uint32_t> Meshes;
+    DynamicArray<uint32_t> Children;
+  };
+
+  struct QuantizedVertex {
+    uint16_t Position[4];
+    int16_t Normal[2];
+    uint16_t TexCoords[2];
+  };
+
+  static_assert(sizeof(QuantizedVertex) == 16, "QuantizedVertex must match the quantized vertex layout");
+
+  // Fills the float vertices, the indices and the bounds
+  static SubMesh ConvertMesh(const aiMesh* mesh, DynamicArray<float>& vertices);
+
+  // Cache order first, the overdraw pass only regroups its clusters and the meshlets regroup the triangles locally again, the vertex fetch order follows the
+  // final index order
+  // The levels of detail share the vertices, so the fetch order is computed once over all of them with the coarsest level first. Every level then only
+  // references a prefix of the vertices, which is all a streamed mesh needs to upload to draw it
+  static void OptimizeSubMesh(SubMesh& subMesh, DynamicArray<float>& vertices, VertexCacheStatistics& statisticsBefore, VertexCacheStatistics& statisticsAfter);
+
+  // Lays the levels out coarsest first, so drawing a level only needs the indices up to its end. The meshlets move along with the full resolution level
+  static void ReverseLevels(SubMesh& subMesh);
+
+  // Each level is simplified from the previous one, its error adds up the errors of all steps so it stays relative to the full resolution mesh. The levels
+  // are appended after the full resolution level, ReverseLevels puts them into their final order
+  static void BuildLevels(SubMesh& subMesh, const DynamicArray<float>& vertices);
+
+  // Submeshes whose indices fit into 16 bits upload them narrowed, 0xffff stays unused so it can never be mistaken for a primitive restart
+  static ReferencePointer<IndexBuffer> CreateIndexBuffer(const ReferencePointer<GeometryBuffer>& geometryBuffer, const SubMesh& subMesh);
+
+  // Only the coarsest levels of the streamed meshes, the finer ones are accounted by MeshStreaming::GetStats
+  size_t GetGPUMemoryUsage() const;
+
+  // The reader keeps the asset alive, so the source stays readable for as long as the streamed mesh exists. Unload only runs once nothing else
+  // references the asset and a reload loads into a new instance
+  StreamedMeshDescription GetStreamedMeshDescription(uint32_t index);
+
+  static uint32_t GetVertexStride() { return s_VertexFormat == MeshVertexFormat::Quantized ? sizeof(QuantizedVertex) : s_VertexFloatCount * sizeof(float); }
+
+  // Half positions keep 11 significant bits, enough for meshes authored around their origin at the usual metre scale
+  static void PackVertices(SubMesh& subMesh, const DynamicArray<float>& vertices);
+
+  // Writes position, normal and texture coordinates per vertex (the vertex buffer layout) and computes the bounds in the same pass
+  static void InterleaveVertices(float* out, const aiVector3D* positions, const aiVector3D* normals, const aiVector3D* texCoords, uint32_t count, glm::vec3& boundsMin,
+                                 glm::vec3& boundsMax);
+
+  // Textures are recorded as dependencies but do not change the cooked geometry, so they are left out of the key
+  static CacheKey GetCookKey(const DynamicArray<char>& source, const DynamicArray<std::filesystem::path>& dependencies, const MeshImportSettings& settings);
+
+  // Cooked layout: CookedHeader, per submesh CookedSubMesh followed by the vertices (already in the vertex format), the indices (coarsest level first), the levels
+  // of detail and the meshlets, per node CookedNode followed by the name, the mesh indices and the child indices
+  struct CookedHeader {
+    char Magic[4];
+    uint32_t Version;
+    uint32_t SubMeshCount;
+    uint32_t NodeCount;
+    MeshVertexFormat VertexFormat;
+  };
+
+  struct CookedSubMesh {
+    uint64_t VertexCount;
+    uint64_t IndexCount;
+    uint64_t LevelCount;
+    uint64_t MeshletCount;
+    float BoundsMin[3];
+    float BoundsMax[3];
+    float BoundsCenter[3];
+    float BoundsRadius;
+  };
+
+  struct CookedNode {
+    uint32_t NameLength;
+    uint32_t MeshCount;
+    uint32_t ChildCount;
+  };
+
+  DynamicArray<char> WriteCooked() const;
+
+  // Returns false for truncated, damaged or outdated blobs, the caller falls back to importing the source
+  bool ReadCooked(const DynamicArray<char>& data);
+
+  uint32_t HandleNode(const aiNode* node);
+
+  void SpawnNode(uint32_t index, const String& name, const ScopePointer<Scene>& scene, Entity parent, const DynamicArray<MeshRendererComponent::SubMesh>& subMeshes);
+
+  // The node's sphere is centered on the union of the boxes and encloses the spheres of all its submeshes
+  const BoundsComponent& AddBoundsComponent(Entity entity, const Node& node) const;
+
+  // The submeshes of a node switch levels together, so each threshold is taken from the submesh with the largest error at that level
+  void AddLODComponent(Entity entity, const Node& node, float radius) const;
+
+  // Position, normal and texture coordinates
+  static constexpr uint32_t s_VertexFloatCount = 8;
+  // Levels are switched when their error would span this many pixels on a viewport of the reference height
+  static constexpr float s_LODPixelError = 1.0f;
+  static constexpr float s_LODReferenceHeight = 1080.0f;
+  static constexpr float s_MinLevelReduction = 0.9f;
+  // Bump whenever the cooked layout or the vertex conversion changes
+  static constexpr uint32_t s_CookedVersion = 7;
+  static MeshVertexFormat s_VertexFormat;
+  static MeshLODSettings s_LODSettings;
 
   std::filesystem::path m_Filepath;
-  const aiScene* m_Scene;
+  DynamicArray<SubMesh> m_SubMeshes;
+  DynamicArray<Node> m_Nodes;
+  // Null until a spawn needs them
+  DynamicArray<ReferencePointer<VertexArray>> m_VertexArrays;
+  // Weak so the streamed meshes, which keep the asset alive, are released with the last entity drawing them
+  DynamicArray<std::weak_ptr<StreamedMesh>> m_StreamedMeshes;
 };
 }  // namespace Hydrogen
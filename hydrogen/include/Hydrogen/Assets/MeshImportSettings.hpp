@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include "../Core/Memory.hpp"
+
+namespace Hydrogen {
+// Import settings of one mesh asset, read from a YAML sidecar next to the source (e.g. viking_room.obj.meta):
+//
+//   Preset: Fast            # Default or Fast, the keys below override the preset
+//   PostProcess:
+//     GenerateNormals: true
+//     OptimizeMeshes: true
+//     OptimizeGraph: false
+//     FlipUVs: false
+//   Attributes:
+//     Normals: true
+//     TexCoords: true
+//
+// Only bools, so the struct can be hashed into the cook key as is
+struct MeshImportSettings {
+  // Smooth normals for meshes that come without any, only if normals are emitted
+  bool GenerateNormals = true;
+  // Merges meshes that share a material, fewer submeshes mean fewer draws
+  bool OptimizeMeshes = true;
+  // Collapses the node hierarchy, off by default because it drops the node names entities are looked up by
+  bool OptimizeGraph = false;
+  bool FlipUVs = false;
+
+  // Attributes that are not emitted are removed before the vertices are joined, so vertices that only differed in them merge and the missing
+  // attributes read as zero. Tangents are never computed, no vertex format carries them
+  bool Normals = true;
+  bool TexCoords = true;
+
+  // The fast preset skips every optional post-process
+  static MeshImportSettings GetPreset(const String& name);
+
+  // Missing or unreadable sidecars give the default settings
+  static MeshImportSettings Load(const std::filesystem::path& assetFilepath);
+  static std::filesystem::path GetFilepath(const std::filesystem::path& assetFilepath);
+
+  uint32_t GetPostProcessFlags() const;
+  // The aiComponent flags for aiProcess_RemoveComponent
+  int GetRemovedComponents() const;
+};
+}  // namespace Hydrogen
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../Core/Memory.hpp"
+#include "../Renderer/Meshlet.hpp"
+
+namespace Hydrogen {
+struct VertexCacheStatistics {
+  uint64_t TransformedVertices = 0;
+  uint64_t TriangleCount = 0;
+  uint64_t VertexCount = 0;
+
+  VertexCacheStatistics& operator+=(const VertexCacheStatistics& other) {
+    TransformedVertices += other.TransformedVertices;
+    TriangleCount += other.TriangleCount;
+    VertexCount += other.VertexCount;
+    return *this;
+  }
+
+  // Average cache miss ratio, vertex shader invocations per triangle (0.5 is ideal for large grids, 3 means no reuse)
+  float GetACMR() const { return TriangleCount ? static_cast<float>(TransformedVertices) / TriangleCount : 0.0f; }
+  // Average transformed vertex ratio, vertex shader invocations per referenced vertex (1 is ideal)
+  float GetATVR() const { return VertexCount ? static_cast<float>(TransformedVertices) / VertexCount : 0.0f; }
+};
+
+// Import-time processing of indexed triangle lists, the reordering passes keep the set of triangles and their winding unchanged
+class MeshOptimizer {
+ public:
+  // Simulates a FIFO post-transform cache of the given size, similar to what current GPUs behave like
+  static VertexCacheStatistics AnalyzeVertexCache(const DynamicArray<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize = 16);
+
+  // Reorders the triangles for post-transform cache reuse (Forsyth, "Linear-Speed Vertex Cache Optimisation")
+  static void OptimizeVertexCache(DynamicArray<uint32_t>& indices, uint32_t vertexCount);
+
+  // Splits the cache optimized order into clusters and draws outward facing clusters first, so early depth rejection culls more of the rest.
+  // The ACMR may get worse by up to the threshold (e.g. 1.05 allows 5%)
+  static void OptimizeOverdraw(DynamicArray<uint32_t>& indices, const float* positions, uint32_t positionStride, uint32_t vertexCount, float threshold = 1.05f);
+
+  // Remaps the vertices into the order of their first use and drops unreferenced ones, returns the new vertex count
+  static uint32_t OptimizeVertexFetch(DynamicArray<float>& vertices, uint32_t vertexFloatCount, DynamicArray<uint32_t>& indices);
+
+  // Groups the triangles into spatially compact meshlets and reorders the indices so that every meshlet is a contiguous range. Triangles are added
+  // greedily, preferring the ones that bring in the fewest new vertices and then the ones closest to the meshlet, seeds follow the input order
+  static DynamicArray<Meshlet> BuildMeshlets(DynamicArray<uint32_t>& indices, const float* positions, uint32_t positionStride, uint32_t vertexCount,
+                                             uint32_t maxVertices = 64, uint32_t maxTriangles = 124);
+
+  // Quadric error metric edge collapse down to the target index count, as long as the error stays below the target error. The result indexes the
+  // unchanged vertices, so all levels of detail can share one vertex buffer. The attributes are the floats following the position in each vertex, their
+  // weights scale them against the position units. Vertices on attribute seams and open borders are kept. The error is an approximate distance in the
+  // units of the positions
+  static DynamicArray<uint32_t> Simplify(const DynamicArray<uint32_t>& indices, const float* vertices, uint32_t vertexFloatCount, uint32_t vertexCount,
+                                         const float* attributeWeights, uint32_t attributeCount, size_t targetIndexCount, float targetError, float* resultError = nullptr);
+
+  // IEEE 754 binary16, rounded to nearest, values outside of the half range become infinity and denormals flush to zero
+  static uint16_t QuantizeHalf(float value);
+  // Clamps to [-1, 1] and rounds to the nearest of the 65535 snorm16 steps
+  static int16_t QuantizeSnorm16(float value);
+  // Maps a unit vector onto the [-1, 1] square of an octahedron unfolded around +z, decoding is
+  // n = (x, y, 1 - |x| - |y|), t = max(-n.z, 0), n.xy -= sign(n.xy) * t, normalize(n)
+  static void EncodeOctahedral(const float* normal, float* encoded);
+};
+}  // namespace Hydrogen
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <chrono>
+#include <cstring>
+#include <fstream>
 #include <functional>
 #include <iostream>
 #include <ostream>
@@ -16,13 +19,18 @@
 #include "../Renderer/Shader.hpp"
 #include "../Renderer/ShaderCompiler.hpp"
 #include "Asset.hpp"
+#include "AssetDependencyGraph.hpp"
+#include "AssetFileSystem.hpp"
 
 namespace Hydrogen {
 class ShaderAsset : public Asset {
  public:
   ShaderAsset() { m_AssetInfo.Preload = true; }
 
-  void Load(const std::filesystem::path& filepath) override {
+  static constexpr AssetType GetStaticType() { return AssetType::Shader; }
+  AssetType GetType() const override { return GetStaticType(); }
+
+  bool Load(const std::filesystem::path& filepath) override {
     HY_ASSERT(!filepath.empty(),
               "Parameter 'filepath' of type 'const String&' in function "
               "ShaderAsset::Load(const String& filepath) is an empty string!");
@@ -30,88 +38,96 @@ class ShaderAsset : public Asset {
 
     m_Name = filepath.filename().string();
 
-    if (filepath.extension() == ".glsl") {
-      for (const auto& dirEntry : std::filesystem::directory_iterator(filepath)) {
-        ShaderStage stage;
-        DynamicArray<uint32_t>* currentShader;
-
-        if (dirEntry.path().extension().string() == ".vert") {
-          currentShader = &m_VertexShader;
-          stage = ShaderStage::VertexShader;
-        } else if (dirEntry.path().extension().string() == ".frag") {
-          currentShader = &m_FragmentShader;
-          stage = ShaderStage::PixelShader;
-        } else if (dirEntry.path().extension().string() == ".geo") {
-          currentShader = &m_GeometryShader;
-          stage = ShaderStage::GeometryShader;
-        } else {
-          continue;
-        }
+    if (filepath.extension() != ".glsl") {
+      HY_LOG_ERROR("Shader {} is not glsl, only glsl is supported for now!", filepath.string());
+      return false;
+    }
+
+    DynamicArray<std::filesystem::path> dependencies;
+    for (const auto& stageFilepath : AssetFileSystem::ListDirectory(filepath)) {
+      ShaderStage stage;
+      DynamicArray<uint32_t>* currentShader;
+
+      auto extension = stageFilepath.extension().string();
+      if (extension == ".vert") {
+        currentShader = &m_VertexShader;
+        stage = ShaderStage::VertexShader;
+      } else if (extension == ".frag") {
+        currentShader = &m_FragmentShader;
+        stage = ShaderStage::PixelShader;
+      } else if (extension == ".geo") {
+        currentShader = &m_GeometryShader;
+        stage = ShaderStage::GeometryShader;
+      } else {
+        continue;
+      }
+
+      String shaderFilepath = stageFilepath.string();
+
+      auto source = AssetFileSystem::ReadFile(stageFilepath);
+      if (!source) {
+        HY_LOG_ERROR("Failed to open file {}", shaderFilepath);
+        return false;
+      }
+      String inbuf(source->begin(), source->end());
+
+      ShaderCompiler compiler(ShaderLanguage::GLSL, ShaderClient::Vulkan_1_0, SpriVVersion::SpriV_1_0, stage, 450);
+
+      CacheKey key = compiler.GetCacheKey();
+      key.Add(inbuf);
+      dependencies.push_back(stageFilepath);
+      for (const auto& [include, includeSource] : CollectIncludes(stageFilepath, inbuf)) {
+        dependencies.push_back(include);
+        key.Add(include.generic_string());
+        // A missing include is part of the key as well, so creating it later invalidates the artifact
+        key.Add(includeSource.has_value());
+        if (includeSource) key.Add(*includeSource);
+      }
+
+      CacheFile cache(shaderFilepath, key);
+
+      if (auto cached = cache.Read()) {
+        currentShader->resize(cached->size() / sizeof(uint32_t));
+        std::memcpy(currentShader->data(), cached->data(), currentShader->size() * sizeof(uint32_t));
+      } else {
+        HY_LOG_INFO("Shader cache {} is invalid. Recompiling!", shaderFilepath)
 
-        String shaderFilepath = dirEntry.path().string();
-
-        std::ifstream infile;
-        infile.open(shaderFilepath, std::ios::in);
-        HY_ASSERT(infile.is_open(), "Failed to open file {}", shaderFilepath);
-        std::stringstream instream;
-        instream << infile.rdbuf();
-        infile.close();
-        String inbuf = instream.str();
-
-        String outfilepath = "cache/" + shaderFilepath;
-        CacheFile cache(outfilepath, inbuf);
-
-        if (!cache.CacheValid()) {
-          HY_LOG_INFO("Shader cache {} is invalid. Recompiling!", shaderFilepath)
-
-          ShaderCompiler compiler(ShaderLanguage::GLSL, ShaderClient::Vulkan_1_0, SpriVVersion::SpriV_1_0, stage, 450);
-          compiler.AddShader(inbuf);
-          compiler.Link();
-          auto spirv = compiler.GetSpriv();
-          currentShader->insert(currentShader->end(), spirv.begin(), spirv.end());
-
-          String directory = DIRECTORY_FROM_PATH(outfilepath);
-          if (!std::filesystem::exists(directory)) {
-            std::filesystem::create_directories(directory);
-          }
-
-          std::ofstream outfile;
-          outfile.open(outfilepath, std::ios::out | std::ios::binary);
-          HY_ASSERT(outfile.is_open(), "Failed to open file {}!", outfilepath);
-          outfile.write(reinterpret_cast<const char*>(currentShader->data()), currentShader->size() * sizeof(uint32_t));
-          outfile.close();
-        } else {
-          std::uintmax_t fileSize = std::filesystem::file_size(outfilepath);
-          std::ifstream infile2;
-
-          infile2.open(outfilepath, std::ios::in | std::ios::binary);
-          HY_ASSERT(infile2.is_open(), "Failed to open file {}!", outfilepath);
-          infile2.unsetf(std::ios::skipws);
-
-          DynamicArray<char> fileData(fileSize);
-          infile2.read(fileData.data(), fileSize);
-
-          currentShader->resize(fileSize / sizeof(uint32_t));
-          std::memcpy(currentShader->data(), fileData.data(), fileSize);
-
-          infile2.close();
+        // The compiler logs the errors, a broken stage fails the whole shader so a reload keeps the previous one
+        if (!compiler.AddShader(inbuf) || !compiler.Link()) {
+          HY_LOG_ERROR("Failed to compile shader {}", shaderFilepath);
+          // Fixing one of the includes has to trigger the next reload as well
+          AssetDependencyGraph::SetDependencies(filepath, dependencies);
+          return false;
         }
+        *currentShader = compiler.GetSpriv();
 
-        cache.UpdateCacheChecksum();
+        cache.Write(currentShader->data(), currentShader->size() * sizeof(uint32_t));
       }
-    } else {
-      HY_INVOKE_ERROR("Only glsl is supported for now!");
     }
 
+    AssetDependencyGraph::SetDependencies(filepath, dependencies);
+
     HY_LOG_INFO("Finished loading shader asset '{}'!", filepath.string());
+    return true;
   }
 
   ReferencePointer<Shader> CreateShader(const ReferencePointer<RenderDevice>& renderDevice, const ReferencePointer<SwapChain>& swapChain,
                                         const ReferencePointer<Framebuffer>& framebuffer, const BufferLayout& vertexLayout,
                                         const ShaderDependencyGraph dependencyGraph) {
-    return Shader::Create(renderDevice, swapChain, framebuffer, vertexLayout, dependencyGraph, m_Name, m_VertexShader, m_FragmentShader, m_GeometryShader);
+    auto startTime = std::chrono::steady_clock::now();
+    auto shader = Shader::Create(renderDevice, swapChain, framebuffer, vertexLayout, dependencyGraph, m_Name, m_VertexShader, m_FragmentShader, m_GeometryShader);
+    RecordUpload(GetMemoryUsage(), std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count());
+    return shader;
+  }
+
+  void Unload() override {
+    m_VertexShader = DynamicArray<uint32_t>();
+    m_FragmentShader = DynamicArray<uint32_t>();
+    m_GeometryShader = DynamicArray<uint32_t>();
   }
 
+  size_t GetMemoryUsage() const override { return (m_VertexShader.size() + m_FragmentShader.size() + m_GeometryShader.size()) * sizeof(uint32_t); }
+
   const DynamicArray<uint32_t>& GetVertexShader() { return m_VertexShader; }
   const DynamicArray<uint32_t>& GetPixelShader() { return m_FragmentShader; }
   const DynamicArray<uint32_t>& GetGeometryShader() { return m_GeometryShader; }
@@ -125,6 +141,42 @@ class ShaderAsset : public Asset {
   }
 
  private:
+  // Resolves '#include "file"' directives recursively, so that editing an included file invalidates the cached SPIR-V
+  static DynamicArray<std::pair<std::filesystem::path, std::optional<String>>> CollectIncludes(const std::filesystem::path& filepath, const String& source) {
+    DynamicArray<std::pair<std::filesystem::path, std::optional<String>>> includes;
+    DynamicArray<std::pair<std::filesystem::path, String>> pending = {{filepath, source}};
+
+    while (!pending.empty()) {
+      auto [currentPath, currentSource] = pending.back();
+      pending.pop_back();
+
+      std::istringstream lines(currentSource);
+      String line;
+      while (std::getline(lines, line)) {
+        auto directive = line.find_first_not_of(" \t");
+        if (directive == String::npos || line.compare(directive, 8, "#include") != 0) continue;
+
+        auto first = line.find_first_of("\"<", directive + 8);
+        auto last = line.find_first_of("\">", first + 1);
+        if (first == String::npos || last == String::npos) continue;
+
+        auto includePath = (currentPath.parent_path() / line.substr(first + 1, last - first - 1)).lexically_normal();
+        if (std::find_if(includes.begin(), includes.end(), [&includePath](const auto& include) { return include.first == includePath; }) != includes.end()) continue;
+
+        auto includeFile = AssetFileSystem::ReadFile(includePath);
+        if (!includeFile) {
+          includes.push_back({includePath, std::nullopt});
+          continue;
+        }
+        String includeSource(includeFile->begin(), includeFile->end());
+        includes.push_back({includePath, includeSource});
+        pending.push_back({includePath, includeSource});
+      }
+    }
+
+    return includes;
+  }
+
   DynamicArray<uint32_t> m_VertexShader;
   DynamicArray<uint32_t> m_FragmentShader;
   DynamicArray<uint32_t> m_GeometryShader;
@@ -1,41 +1,92 @@
 #pragma once
 
 #include <stb_image.h>
+#include <chrono>
+#include <cstring>
 
 #include "../Renderer/Texture.hpp"
 #include "../Core/Assert.hpp"
+#include "../Core/Cache.hpp"
+#include "../Core/Compression.hpp"
 #include "../Core/Logger.hpp"
 #include "Asset.hpp"
+#include "AssetFileSystem.hpp"
 
 namespace Hydrogen {
 class SpriteAsset : public Asset {
  public:
   SpriteAsset() {
-    m_AssetInfo.Preload = true;
-    m_Pixels = nullptr;
+    m_AssetInfo.Preload = false;
     m_Channels = 0;
     m_Width = 0;
     m_Height = 0;
   }
 
-  void Load(const std::filesystem::path& filepath) override {
+  static constexpr AssetType GetStaticType() { return AssetType::Sprite; }
+  AssetType GetType() const override { return GetStaticType(); }
+
+  bool Load(const std::filesystem::path& filepath) override {
     HY_ASSERT(!filepath.empty(),
               "Parameter 'filepath' of type 'const String&' in function "
               "SpriteAsset::Load(const String& filepath) is an empty string!");
     HY_LOG_INFO("Loading sprite asset '{}'!", filepath.string());
-    m_Pixels = stbi_load(filepath.string().c_str(), (int*)&m_Width, (int*)&m_Height, (int*)&m_Channels, STBI_rgb_alpha);
-    HY_ASSERT(m_Pixels, "Failed to load sprite {}", filepath.string());
+    Unload();
+    auto data = AssetFileSystem::ReadFile(filepath);
+    if (!data) {
+      HY_LOG_ERROR("Failed to read sprite {}", filepath.string());
+      return false;
+    }
+
+    // The decoded pixels are cooked, so images are only decoded once per content change. They are stored compressed, raw RGBA of large textures would
+    // fill the cache budget with a few files
+    CacheKey key;
+    key.Add(s_CookedVersion);
+    key.Add(data->data(), data->size());
+    CacheFile cache(filepath.string() + ".rgba", key);
+
+    if (auto cooked = cache.Read(); cooked && ReadCooked(*cooked)) {
+      HY_LOG_INFO("Finished loading sprite asset '{}' from cooked cache!", filepath.string());
+      return true;
+    }
+
+    auto pixels = stbi_load_from_memory((const stbi_uc*)data->data(), (int)data->size(), (int*)&m_Width, (int*)&m_Height, (int*)&m_Channels, STBI_rgb_alpha);
+    if (!pixels) {
+      HY_LOG_ERROR("Failed to decode sprite {}: {}", filepath.string(), stbi_failure_reason());
+      return false;
+    }
+    m_Pixels.assign(pixels, pixels + static_cast<size_t>(m_Width) * m_Height * STBI_rgb_alpha);
+    stbi_image_free(pixels);
+
+    auto compressed = Compression::Compress(m_Pixels.data(), m_Pixels.size());
+    bool storeCompressed = compressed.size() < m_Pixels.size();
+    const auto& stored = storeCompressed ? compressed : m_Pixels;
+
+    CookedHeader header{{'H', 'Y', 'S', 'P'}, s_CookedVersion, m_Width, m_Height, m_Channels, storeCompressed};
+    DynamicArray<char> cookedData(sizeof(CookedHeader) + stored.size());
+    std::memcpy(cookedData.data(), &header, sizeof(CookedHeader));
+    std::memcpy(cookedData.data() + sizeof(CookedHeader), stored.data(), stored.size());
+    cache.Write(cookedData.data(), cookedData.size());
     HY_LOG_INFO("Finished loading sprite asset '{}'!", filepath.string());
+    return true;
   }
 
   ReferencePointer<Texture2D> CreateTexture2D(const ReferencePointer<RenderDevice>& renderDevice) {
-    HY_ASSERT(m_Pixels, "SpriteAsset already created Texture2D or is uninitialized!");
-    auto texture = Texture2D::Create(renderDevice, m_Width, m_Height, m_Pixels);
-    stbi_image_free(m_Pixels);
-    m_Pixels = nullptr;
+    HY_ASSERT(!m_Pixels.empty(), "SpriteAsset already created Texture2D or is uninitialized!");
+    auto startTime = std::chrono::steady_clock::now();
+    auto texture = Texture2D::Create(renderDevice, m_Width, m_Height, m_Pixels.data());
+    RecordUpload(m_Pixels.size(), std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count());
+    Unload();
+    MarkUnloaded();
     return texture;
   }
 
+  void Unload() override {
+    m_Pixels.clear();
+    m_Pixels.shrink_to_fit();
+  }
+
+  size_t GetMemoryUsage() const override { return m_Pixels.size(); }
+
   static const DynamicArray<String> GetFileExtensions() { return DynamicArray<String>{".jpg", ".jpeg", ".png", ".tga", ".bmp", ".psd", ".gif", ".hdr", ".pic", ".pnm"}; }
 
   static bool CheckFileExtensions(const String& ext) {
@@ -44,7 +95,49 @@ class SpriteAsset : public Asset {
   }
 
  private:
-  stbi_uc* m_Pixels;
+  struct CookedHeader {
+    char Magic[4];
+    uint32_t Version;
+    uint32_t Width;
+    uint32_t Height;
+    uint32_t Channels;
+    // Incompressible pixels are stored raw
+    uint32_t Compressed;
+  };
+
+  bool ReadCooked(const DynamicArray<char>& data) {
+    if (data.size() < sizeof(CookedHeader)) return false;
+
+    CookedHeader header;
+    std::memcpy(&header, data.data(), sizeof(CookedHeader));
+    if (std::memcmp(header.Magic, "HYSP", 4) != 0 || header.Version != s_CookedVersion) return false;
+
+    auto stored = data.data() + sizeof(CookedHeader);
+    auto storedSize = data.size() - sizeof(CookedHeader);
+    auto pixelSize = static_cast<size_t>(header.Width) * header.Height * STBI_rgb_alpha;
+    if (header.Compressed) {
+      // The codec expands at most 255 times, damaged dimensions fail here instead of in the allocation
+      if (pixelSize / 255 > storedSize) return false;
+      m_Pixels.resize(pixelSize);
+      if (!Compression::Decompress(stored, storedSize, m_Pixels.data(), m_Pixels.size())) {
+        Unload();
+        return false;
+      }
+    } else {
+      if (storedSize != pixelSize) return false;
+      m_Pixels.assign(stored, stored + storedSize);
+    }
+
+    m_Width = header.Width;
+    m_Height = header.Height;
+    m_Channels = header.Channels;
+    return true;
+  }
+
+  // Bump whenever CookedHeader or the pixel layout changes
+  static constexpr uint32_t s_CookedVersion = 2;
+
+  DynamicArray<uint8_t> m_Pixels;
   uint32_t m_Channels;
   uint32_t m_Width;
   uint32_t m_Height;
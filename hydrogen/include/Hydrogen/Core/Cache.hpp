@@ -1,19 +1,66 @@
 #pragma once
 
+#include <filesystem>
 #include <optional>
+#include <type_traits>
 #include "Memory.hpp"
 
 namespace Hydrogen {
+class CacheKey {
+ public:
+  // Every key is salted with the engine version and the cache format version
+  CacheKey();
+
+  CacheKey& Add(const void* data, size_t size);
+  CacheKey& Add(const String& value);
+  CacheKey& Add(const char* value);
+
+  template <typename T>
+  CacheKey& Add(const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+    return Add(&value, sizeof(T));
+  }
+
+  uint64_t GetValue() const { return m_Value; }
+  String ToString() const;
+
+ private:
+  uint64_t m_Value;
+};
+
+// The cache directory may be shared between processes: readers take no locks, writers publish through an atomic rename.
+// Artifacts missing on disk are looked up below the pack directory of the mounted asset packs, where pre-cooked builds ship them
 class CacheFile {
  public:
-  CacheFile(const String& path, const String& content);
+  CacheFile(const std::filesystem::path& path, const CacheKey& key);
   ~CacheFile() = default;
-  bool CacheValid();
-  void UpdateCacheChecksum();
+
+  // Returns std::nullopt if the artifact does not exist or was evicted concurrently
+  std::optional<DynamicArray<char>> Read();
+  void Write(const void* data, size_t size);
+
+  const std::filesystem::path& GetFilepath() const { return m_CacheFilepath; }
+
+  static constexpr const char* s_PackDirectory = "cache";
+  static constexpr const char* s_MetadataDirectory = "metadata";
+
+  static void SetDirectory(const std::filesystem::path& directory) { s_Directory = directory; }
+  static const std::filesystem::path& GetDirectory() { return s_Directory; }
+  // Shared like the artifacts but never collected, for data the cache keys are computed from (e.g. the asset dependency graph)
+  static std::filesystem::path GetMetadataDirectory() { return s_Directory / s_MetadataDirectory; }
+  // Unique per process, thread and call, so concurrent writers of the same file never share a temporary file. Leftovers of crashed writers are collected
+  static std::filesystem::path GetTemporaryFilepath(const std::filesystem::path& filepath);
+  static void SetBudget(uintmax_t bytes) { s_Budget = bytes; }
+  static uintmax_t GetBudget() { return s_Budget; }
+
+  // Evicts the least recently used artifacts until the cache directory fits into the budget, returns the number of bytes freed. The metadata is kept
+  static uintmax_t CollectGarbage();
 
  private:
-  size_t m_ContentChecksum;
-  std::optional<size_t> m_CacheCecksum;
-  String m_CacheFilepath;
+  std::filesystem::path m_CacheFilepath;
+  std::filesystem::path m_PackFilepath;
+
+  static std::filesystem::path s_Directory;
+  static uintmax_t s_Budget;
 };
 }  // namespace Hydrogen
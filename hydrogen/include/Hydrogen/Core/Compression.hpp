@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "Memory.hpp"
+
+namespace Hydrogen {
+// Byte oriented LZ77 codec in the spirit of the LZ4 block format, fast to decode straight out of a memory mapped archive
+class Compression {
+ public:
+  // The result may be larger than the input for incompressible data, callers should store the raw bytes in that case
+  static DynamicArray<uint8_t> Compress(const void* data, size_t size);
+  // Returns false if the stream is malformed or does not decode to exactly decompressedSize bytes
+  static bool Decompress(const void* data, size_t size, void* decompressed, size_t decompressedSize);
+};
+}  // namespace Hydrogen
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include "Memory.hpp"
+#include "Platform.hpp"
+
+namespace Hydrogen {
+// Recursively watches a directory, uses inotify on Linux and falls back to polling modification times elsewhere
+class FileWatcher {
+ public:
+  FileWatcher(const std::filesystem::path& directory);
+  ~FileWatcher();
+
+  FileWatcher(const FileWatcher&) = delete;
+  FileWatcher& operator=(const FileWatcher&) = delete;
+
+  // Files that were written, created, moved in or removed since the last call, never blocks
+  DynamicArray<std::filesystem::path> Poll();
+
+ private:
+  std::filesystem::path m_Directory;
+#if defined HY_PLATFORM_LINUX
+  void AddWatches(const std::filesystem::path& directory);
+
+  int m_Descriptor = -1;
+  UnorderedMap<int, std::filesystem::path> m_Watches;
+#else
+  UnorderedMap<String, std::filesystem::file_time_type> m_Timestamps;
+  std::chrono::steady_clock::time_point m_LastScan;
+#endif
+};
+}  // namespace Hydrogen
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Hydrogen {
+// FNV-1a is used instead of std::hash wherever hashes are persisted (cache keys, asset packs) and must not depend on the standard library implementation
+class Hash {
+ public:
+  static constexpr uint64_t s_FNVOffsetBasis = 0xcbf29ce484222325ULL;
+  static constexpr uint64_t s_FNVPrime = 0x100000001b3ULL;
+
+  // Continues hashing from a previous result, so a value can be hashed in pieces
+  static uint64_t FNV1a(const void* data, size_t size, uint64_t hash = s_FNVOffsetBasis) {
+    auto bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash ^= bytes[i];
+      hash *= s_FNVPrime;
+    }
+    return hash;
+  }
+};
+}  // namespace Hydrogen
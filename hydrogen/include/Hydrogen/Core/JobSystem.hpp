@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include "Memory.hpp"
+
+namespace Hydrogen {
+class JobSystem {
+ public:
+  // A thread count of 0 uses one worker per hardware thread except the calling one
+  static void Init(uint32_t threadCount = 0);
+  static void Shutdown();
+
+  // Jobs run inline if the job system is not initialized
+  static void Execute(const std::function<void()>& job);
+
+  template <typename F>
+  static std::future<std::invoke_result_t<F>> Submit(F&& job) {
+    auto task = NewReferencePointer<std::packaged_task<std::invoke_result_t<F>()>>(std::forward<F>(job));
+    auto future = task->get_future();
+    Execute([task]() { (*task)(); });
+    return future;
+  }
+
+  // Runs job(index) for every index in [0, count) across all workers, the calling thread participates until all indices are done
+  static void Dispatch(uint32_t count, const std::function<void(uint32_t)>& job);
+
+  // Blocks until the future is ready, executing queued jobs in the meantime so waiting on workers can not deadlock
+  template <typename T>
+  static void Wait(const std::shared_future<T>& future) {
+    if (!future.valid()) return;
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      if (!RunPendingJob()) future.wait_for(std::chrono::microseconds(100));
+    }
+  }
+
+  // Blocks until every queued job has finished
+  static void WaitForIdle();
+
+  // Pops a single queued job and runs it on the calling thread, returns false if the queue was empty
+  static bool RunPendingJob();
+
+  // Main thread jobs are deferred to the next frame boundary (e.g. GPU uploads and load callbacks)
+  static void ExecuteOnMainThread(const std::function<void()>& job);
+  static void ProcessMainThreadJobs();
+
+  static uint32_t GetThreadCount();
+  static bool IsInitialized();
+
+ private:
+  static void WorkerLoop();
+
+  static DynamicArray<std::thread> s_Workers;
+  static std::deque<std::function<void()>> s_Jobs;
+  static std::mutex s_JobsMutex;
+  static std::condition_variable s_JobsAvailable;
+  static std::condition_variable s_JobsFinished;
+  static uint64_t s_PendingJobs;
+  static bool s_Running;
+
+  static DynamicArray<std::function<void()>> s_MainThreadJobs;
+  static std::mutex s_MainThreadJobsMutex;
+};
+}  // namespace Hydrogen
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include "Platform.hpp"
+
+namespace Hydrogen {
+// Read-only memory mapping of a whole file, pages are faulted in by the OS on first access
+class MappedFile {
+ public:
+  MappedFile(const std::filesystem::path& filepath);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool IsValid() const { return m_Data != nullptr; }
+  const uint8_t* GetData() const { return m_Data; }
+  size_t GetSize() const { return m_Size; }
+  const std::filesystem::path& GetFilepath() const { return m_Filepath; }
+
+ private:
+  std::filesystem::path m_Filepath;
+  const uint8_t* m_Data = nullptr;
+  size_t m_Size = 0;
+#if defined HY_PLATFORM_WINDOWS
+  void* m_FileHandle = nullptr;
+  void* m_MappingHandle = nullptr;
+#endif
+};
+}  // namespace Hydrogen
@@ -121,6 +121,15 @@
 #define HY_ARCH_WASM
 #endif
 
+// SIMD instruction set detection
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HY_SIMD_SSE2
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define HY_SIMD_NEON
+#endif
+
 namespace Hydrogen {
 enum class Platform { Windows, WindowsPC, XBoxOne, Unix, Apple, MacOS, IOS, Web, Android, Linux, DragonFlyBSD, FreeBSD, NetBSD, OpenBSD, AkarOS, Solaris, Playstation, Nintendo };
 
@@ -1,14 +1,25 @@
 #pragma once
 
 #include "Assets/Asset.hpp"
+#include "Assets/AssetDependencyGraph.hpp"
+#include "Assets/AssetFileSystem.hpp"
+#include "Assets/AssetHandle.hpp"
 #include "Assets/AssetManager.hpp"
+#include "Assets/AssetPack.hpp"
+#include "Assets/MeshImportSettings.hpp"
+#include "Assets/MeshOptimizer.hpp"
 #include "Assets/ShaderAsset.hpp"
 #include "Assets/SpriteAsset.hpp"
 #include "Core/Application.hpp"
 #include "Core/Assert.hpp"
 #include "Core/Cache.hpp"
+#include "Core/Compression.hpp"
 #include "Core/Entry.hpp"
+#include "Core/FileWatcher.hpp"
+#include "Core/Hash.hpp"
+#include "Core/JobSystem.hpp"
 #include "Core/Logger.hpp"
+#include "Core/MappedFile.hpp"
 #include "Core/Memory.hpp"
 #include "Core/Platform.hpp"
 #include "Core/Task.hpp"
@@ -16,5 +27,7 @@
 #include "Events/EventSystem.hpp"
 #include "Events/KeyCodes.hpp"
 #include "Math/Math.hpp"
+#include "Renderer/MeshStreaming.hpp"
+#include "Renderer/Meshlet.hpp"
 #include "Renderer/Renderer.hpp"
 #include "Scene/Scene.hpp"
@@ -4,6 +4,11 @@
 #include <vulkan/vulkan.h>
 
 namespace Hydrogen::Vulkan {
+struct VulkanBufferCopy {
+  VkBuffer Destination;
+  VkBufferCopy Region;
+};
+
 class VulkanBuffer {
  public:
   VulkanBuffer(ReferencePointer<class VulkanRenderDevice> renderDevice, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties);
@@ -12,6 +17,11 @@ class VulkanBuffer {
   VkBuffer GetBuffer() { return m_Buffer; }
   VkDeviceMemory GetBufferMemory() { return m_BufferMemory; }
 
+  // Copies into a device local buffer through a staging buffer and waits for the copy to finish
+  void Upload(const void* data, VkDeviceSize size, VkDeviceSize offset = 0);
+  // Records all copies from this buffer into one command buffer and waits for them to finish
+  void CopyTo(const DynamicArray<VulkanBufferCopy>& copies);
+
  protected:
   ReferencePointer<class VulkanRenderDevice> m_RenderDevice;
   VkBuffer m_Buffer;
@@ -20,13 +30,14 @@ class VulkanBuffer {
 
 class VulkanVertexBuffer : public VertexBuffer, public VulkanBuffer {
  public:
-  VulkanVertexBuffer(const ReferencePointer<RenderDevice>& device, float* vertices, size_t size);
+  VulkanVertexBuffer(const ReferencePointer<RenderDevice>& device, const void* vertices, size_t size);
   virtual ~VulkanVertexBuffer();
 
   virtual void Bind(const ReferencePointer<CommandBuffer>& commandBuffer) const override;
 
   virtual const BufferLayout& GetLayout() const override { return m_Layout; }
   virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+  virtual uint64_t GetOffset() const override { return 0; }
 
   VkBuffer GetVertexBuffer() { return m_Buffer; }
   size_t GetSize() { return m_Size; }
@@ -38,15 +49,18 @@ class VulkanVertexBuffer : public VertexBuffer, public VulkanBuffer {
 
 class VulkanIndexBuffer : public IndexBuffer, public VulkanBuffer {
  public:
-  VulkanIndexBuffer(const ReferencePointer<RenderDevice>& device, uint32_t* indices, size_t size);
+  VulkanIndexBuffer(const ReferencePointer<RenderDevice>& device, const void* indices, size_t size, IndexType type);
   virtual ~VulkanIndexBuffer();
 
   virtual void Bind(const ReferencePointer<CommandBuffer>& commandBuffer) const override;
 
   virtual size_t GetCount() const override { return m_Count; }
+  virtual IndexType GetIndexType() const override { return m_Type; }
+  virtual uint64_t GetOffset() const override { return 0; }
 
  private:
   size_t m_Count;
+  IndexType m_Type;
 };
 
 class VulkanUniformBuffer : public UniformBuffer, public VulkanBuffer {
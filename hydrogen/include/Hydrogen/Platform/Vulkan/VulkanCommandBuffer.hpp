@@ -20,10 +20,15 @@ class VulkanCommandBuffer : public CommandBuffer {
   virtual void CmdDisplayImage(const ReferencePointer<class SwapChain> swapChain) override;
   virtual void CmdDraw(const ReferencePointer<class VertexBuffer>& vertexBuffer) override;
   virtual void CmdDrawIndexed(const ReferencePointer<class VertexArray>& vertexArray) override;
+  virtual void CmdDrawIndexed(const ReferencePointer<class VertexArray>& vertexArray, uint32_t indexCount, uint32_t firstIndex) override;
   virtual void CmdSetViewport(const ReferencePointer<class SwapChain>& swapChain, uint32_t width = UINT32_MAX, uint32_t height = UINT32_MAX) override;
   virtual void CmdSetScissor(const ReferencePointer<class SwapChain>& swapChain, int offsetX = 0, int offsetY = 0) override;
   virtual void CmdDrawImGuiDrawData(const ReferencePointer<class Shader>& shader = nullptr) override;
 
+  // Skip the bind if the buffer is already bound, consecutive draws from the same geometry buffer page only bind it once
+  void BindVertexBuffer(VkBuffer buffer);
+  void BindIndexBuffer(VkBuffer buffer, VkIndexType type);
+
   VkCommandBuffer GetCommandBuffer() { return m_CommandBuffer; }
   VkSemaphore GetImageAvailableSemaphore() { return m_ImageAvailableSemaphore; }
   VkSemaphore GetRenderFinishedSemaphore() { return m_RenderFinishedSemaphore; }
@@ -38,5 +43,9 @@ class VulkanCommandBuffer : public CommandBuffer {
   VkSemaphore m_RenderFinishedSemaphore;
   VkFence m_InFlightFence;
   uint32_t m_ImageIndex;
+
+  VkBuffer m_BoundVertexBuffer = VK_NULL_HANDLE;
+  VkBuffer m_BoundIndexBuffer = VK_NULL_HANDLE;
+  VkIndexType m_BoundIndexType = VK_INDEX_TYPE_UINT32;
 };
 }  // namespace Hydrogen::Vulkan
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <mutex>
+#include "../../Renderer/GeometryBuffer.hpp"
+#include "../../Renderer/BufferAllocator.hpp"
+#include "VulkanBuffer.hpp"
+
+namespace Hydrogen::Vulkan {
+class VulkanGeometryBuffer : public GeometryBuffer, public std::enable_shared_from_this<VulkanGeometryBuffer> {
+ public:
+  struct Allocation {
+    uint32_t Page;
+    uint64_t Offset;
+    uint64_t Size;
+  };
+
+  VulkanGeometryBuffer(const ReferencePointer<RenderDevice>& device, size_t vertexPageSize, size_t indexPageSize);
+  virtual ~VulkanGeometryBuffer() = default;
+
+  virtual ReferencePointer<VertexBuffer> AllocateVertices(const void* vertices, size_t size, uint32_t stride) override;
+  virtual ReferencePointer<IndexBuffer> AllocateIndices(const void* indices, size_t size, IndexType type) override;
+
+  virtual void BeginUploads() override;
+  virtual void SubmitUploads() override;
+
+  virtual void NextFrame() override;
+
+  virtual GeometryBufferStats GetStats() override;
+
+  VkBuffer GetVertexPage(uint32_t page);
+  VkBuffer GetIndexPage(uint32_t page);
+
+  void FreeVertices(const Allocation& allocation);
+  void FreeIndices(const Allocation& allocation);
+
+ private:
+  struct Page {
+    ScopePointer<VulkanBuffer> Buffer;
+    BufferAllocator Allocator;
+  };
+
+  struct PendingFree {
+    DynamicArray<Page>* Pages;
+    Allocation Range;
+    uint32_t FramesLeft;
+  };
+
+  struct PendingUpload {
+    VkBuffer Destination;
+    uint64_t SourceOffset;
+    uint64_t DestinationOffset;
+    uint64_t Size;
+  };
+
+  Allocation Allocate(DynamicArray<Page>& pages, const void* data, uint64_t size, uint64_t alignment, VkBufferUsageFlags usage, uint64_t pageSize);
+  void Free(DynamicArray<Page>& pages, const Allocation& allocation);
+
+  ReferencePointer<VulkanRenderDevice> m_RenderDevice;
+  uint64_t m_VertexPageSize;
+  uint64_t m_IndexPageSize;
+
+  // Pages are never released, so the page indices of the allocations stay valid
+  DynamicArray<Page> m_VertexPages;
+  DynamicArray<Page> m_IndexPages;
+  DynamicArray<PendingFree> m_PendingFrees;
+  uint32_t m_UploadBatchDepth = 0;
+  DynamicArray<uint8_t> m_UploadData;
+  DynamicArray<PendingUpload> m_PendingUploads;
+  // Buffers can be released on worker threads while the main thread allocates
+  std::mutex m_Mutex;
+};
+
+// Range of a geometry buffer page, binds the whole page so draws from the same page share the binding
+class VulkanGeometryVertexBuffer : public VertexBuffer {
+ public:
+  VulkanGeometryVertexBuffer(const ReferencePointer<VulkanGeometryBuffer>& geometryBuffer, const VulkanGeometryBuffer::Allocation& allocation);
+  virtual ~VulkanGeometryVertexBuffer();
+
+  virtual void Bind(const ReferencePointer<CommandBuffer>& commandBuffer) const override;
+
+  virtual const BufferLayout& GetLayout() const override { return m_Layout; }
+  virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+  virtual uint64_t GetOffset() const override { return m_Allocation.Offset; }
+
+ private:
+  ReferencePointer<VulkanGeometryBuffer> m_GeometryBuffer;
+  VulkanGeometryBuffer::Allocation m_Allocation;
+  VkBuffer m_Buffer;
+  BufferLayout m_Layout;
+};
+
+class VulkanGeometryIndexBuffer : public IndexBuffer {
+ public:
+  VulkanGeometryIndexBuffer(const ReferencePointer<VulkanGeometryBuffer>& geometryBuffer, const VulkanGeometryBuffer::Allocation& allocation, IndexType type);
+  virtual ~VulkanGeometryIndexBuffer();
+
+  virtual void Bind(const ReferencePointer<CommandBuffer>& commandBuffer) const override;
+
+  virtual size_t GetCount() const override { return m_Allocation.Size / Hydrogen::Utils::IndexTypeSize(m_Type); }
+  virtual IndexType GetIndexType() const override { return m_Type; }
+  virtual uint64_t GetOffset() const override { return m_Allocation.Offset; }
+
+ private:
+  ReferencePointer<VulkanGeometryBuffer> m_GeometryBuffer;
+  VulkanGeometryBuffer::Allocation m_Allocation;
+  VkBuffer m_Buffer;
+  IndexType m_Type;
+};
+}  // namespace Hydrogen::Vulkan
@@ -16,8 +16,13 @@ class VulkanVertexArray : public VertexArray {
   virtual const DynamicArray<ReferencePointer<VertexBuffer>>& GetVertexBuffers() const override { return m_VertexBuffers; }
   virtual const ReferencePointer<IndexBuffer>& GetIndexBuffer() const override { return m_IndexBuffer; }
 
+  virtual uint32_t GetFirstIndex() const override { return m_FirstIndex; }
+  virtual int32_t GetVertexOffset() const override { return m_VertexOffset; }
+
  private:
   DynamicArray<ReferencePointer<VertexBuffer>> m_VertexBuffers;
   ReferencePointer<IndexBuffer> m_IndexBuffer;
+  uint32_t m_FirstIndex = 0;
+  int32_t m_VertexOffset = 0;
 };
 }  // namespace Hydrogen::Vulkan
@@ -7,9 +7,36 @@ namespace Hydrogen {
 class CommandBuffer;
 class RenderDevice;
 
-enum class ShaderDataType { None = 0, Float = 1, Float2 = 2, Float3 = 3, Float4 = 4, Mat3 = 5, Mat4 = 6, Int = 7, Int2 = 8, Int3 = 9, Int4 = 10, Bool = 11 };
+// The 8 and 16 bit integer types and UInt1010102 (x, y, z in 10 bits each, w in 2 bits) are read as normalized floats by the shader if the element is normalized
+enum class ShaderDataType {
+  None = 0,
+  Float = 1,
+  Float2 = 2,
+  Float3 = 3,
+  Float4 = 4,
+  Mat3 = 5,
+  Mat4 = 6,
+  Int = 7,
+  Int2 = 8,
+  Int3 = 9,
+  Int4 = 10,
+  Bool = 11,
+  Half2 = 12,
+  Half4 = 13,
+  Byte4 = 14,
+  UByte4 = 15,
+  Short2 = 16,
+  Short4 = 17,
+  UShort2 = 18,
+  UShort4 = 19,
+  UInt1010102 = 20
+};
+
+enum class IndexType { UInt16 = 0, UInt32 = 1 };
 
 namespace Utils {
+static uint32_t IndexTypeSize(IndexType type) { return type == IndexType::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t); }
+
 static uint32_t ShaderDataTypeSize(ShaderDataType type) {
   switch (type) {
     case ShaderDataType::Float:
@@ -34,6 +61,24 @@ static uint32_t ShaderDataTypeSize(ShaderDataType type) {
       return 4 * 4;
     case ShaderDataType::Bool:
       return 1;
+    case ShaderDataType::Half2:
+      return 2 * 2;
+    case ShaderDataType::Half4:
+      return 2 * 4;
+    case ShaderDataType::Byte4:
+      return 4;
+    case ShaderDataType::UByte4:
+      return 4;
+    case ShaderDataType::Short2:
+      return 2 * 2;
+    case ShaderDataType::Short4:
+      return 2 * 4;
+    case ShaderDataType::UShort2:
+      return 2 * 2;
+    case ShaderDataType::UShort4:
+      return 2 * 4;
+    case ShaderDataType::UInt1010102:
+      return 4;
     default:
       HY_ASSERT_CHECK(false, "Invalid shader data type");
   }
@@ -77,6 +122,24 @@ struct BufferElement {
         return 4;
       case ShaderDataType::Bool:
         return 1;
+      case ShaderDataType::Half2:
+        return 2;
+      case ShaderDataType::Half4:
+        return 4;
+      case ShaderDataType::Byte4:
+        return 4;
+      case ShaderDataType::UByte4:
+        return 4;
+      case ShaderDataType::Short2:
+        return 2;
+      case ShaderDataType::Short4:
+        return 4;
+      case ShaderDataType::UShort2:
+        return 2;
+      case ShaderDataType::UShort4:
+        return 4;
+      case ShaderDataType::UInt1010102:
+        return 4;
       default:
         HY_ASSERT_CHECK(false, "Invalid shader data type");
     }
@@ -122,8 +185,10 @@ class VertexBuffer {
 
   virtual const BufferLayout& GetLayout() const = 0;
   virtual void SetLayout(const BufferLayout& layout) = 0;
+  // Byte offset of the vertices in the bound buffer, non zero for ranges of the geometry buffer
+  virtual uint64_t GetOffset() const = 0;
 
-  static ReferencePointer<VertexBuffer> Create(const ReferencePointer<RenderDevice>& device, float* vertices, size_t size);
+  static ReferencePointer<VertexBuffer> Create(const ReferencePointer<RenderDevice>& device, const void* vertices, size_t size);
 };
 
 class IndexBuffer {
@@ -132,8 +197,12 @@ class IndexBuffer {
 
   virtual void Bind(const ReferencePointer<CommandBuffer>& commandBuffer) const = 0;
   virtual size_t GetCount() const = 0;
+  virtual IndexType GetIndexType() const = 0;
+  // Byte offset of the indices in the bound buffer, non zero for ranges of the geometry buffer
+  virtual uint64_t GetOffset() const = 0;
 
-  static ReferencePointer<IndexBuffer> Create(const ReferencePointer<RenderDevice>& device, uint32_t* indices, size_t size);
+  // Size is in bytes, the indices have to be of the given type
+  static ReferencePointer<IndexBuffer> Create(const ReferencePointer<RenderDevice>& device, const void* indices, size_t size, IndexType type = IndexType::UInt32);
 };
 
 class UniformBuffer {
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <utility>
+
+namespace Hydrogen {
+// Best fit range allocator for sub-allocating a GPU buffer, it only does the bookkeeping and never touches the memory
+class BufferAllocator {
+ public:
+  BufferAllocator(uint64_t size);
+
+  // Returns the offset of the range, or nothing if no free range is large enough. The alignment does not have to be a power of two, e.g. a vertex stride
+  std::optional<uint64_t> Allocate(uint64_t size, uint64_t alignment = 1);
+  // Takes the offset and size of an allocated range, neighbouring free ranges are merged
+  void Free(uint64_t offset, uint64_t size);
+
+  uint64_t GetSize() const { return m_Size; }
+  uint64_t GetUsedSize() const { return m_UsedSize; }
+  uint64_t GetLargestFreeRange() const { return m_FreeRangesBySize.empty() ? 0 : m_FreeRangesBySize.rbegin()->first; }
+
+ private:
+  void InsertFreeRange(uint64_t offset, uint64_t size);
+  void EraseFreeRange(std::map<uint64_t, uint64_t>::iterator range);
+
+  uint64_t m_Size;
+  uint64_t m_UsedSize = 0;
+  // Offset to size for merging neighbours, (size, offset) for the best fit search
+  std::map<uint64_t, uint64_t> m_FreeRanges;
+  std::set<std::pair<uint64_t, uint64_t>> m_FreeRangesBySize;
+};
+}  // namespace Hydrogen
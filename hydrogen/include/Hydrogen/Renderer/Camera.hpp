@@ -25,6 +25,7 @@ class Camera {
   virtual ~Camera() = default;
 
   const Matrix4& GetViewProj() { return m_ViewProj; }
+  const Matrix4& GetProjection() { return m_Projection; }
 
   const Vector3& GetPosition() { return m_Position; }
 
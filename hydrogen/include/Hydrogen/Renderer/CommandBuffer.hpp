@@ -19,6 +19,8 @@ class CommandBuffer {
   virtual void CmdDisplayImage(const ReferencePointer<class SwapChain> swapChain) = 0;
   virtual void CmdDraw(const ReferencePointer<class VertexBuffer>& vertexBuffer) = 0;
   virtual void CmdDrawIndexed(const ReferencePointer<class VertexArray>& vertexArray) = 0;
+  // Draws a range of the index buffer, e.g. one level of detail
+  virtual void CmdDrawIndexed(const ReferencePointer<class VertexArray>& vertexArray, uint32_t indexCount, uint32_t firstIndex) = 0;
   virtual void CmdSetViewport(const ReferencePointer<class SwapChain>& swapChain, uint32_t width = UINT32_MAX, uint32_t height = UINT32_MAX) = 0;
   virtual void CmdSetScissor(const ReferencePointer<class SwapChain>& swapChain, int offsetX = 0, int offsetY = 0) = 0;
   virtual void CmdDrawImGuiDrawData(const ReferencePointer<class Shader>& shader = nullptr) = 0;
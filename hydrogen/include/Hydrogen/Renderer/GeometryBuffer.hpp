@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../Core/Memory.hpp"
+#include "Buffer.hpp"
+
+namespace Hydrogen {
+struct GeometryBufferStats {
+  uint64_t VertexCapacity = 0;
+  uint64_t VertexUsage = 0;
+  uint64_t IndexCapacity = 0;
+  uint64_t IndexUsage = 0;
+  uint32_t PageCount = 0;
+};
+
+// Shared device local vertex and index memory for all meshes. The memory is split into large pages and every mesh gets a range of one of them, so
+// meshes do not need their own allocations and draws of meshes in the same page share one buffer binding
+class GeometryBuffer {
+ public:
+  virtual ~GeometryBuffer() = default;
+
+  // Uploads into a free range, the returned buffers give their range back when they are destroyed. Vertex ranges are aligned to the stride and index
+  // ranges to the index size, so the draws can address them by vertex offset and first index
+  virtual ReferencePointer<VertexBuffer> AllocateVertices(const void* vertices, size_t size, uint32_t stride) = 0;
+  virtual ReferencePointer<IndexBuffer> AllocateIndices(const void* indices, size_t size, IndexType type) = 0;
+
+  // Allocations between BeginUploads and SubmitUploads are copied through one staging buffer in one submission instead of waiting for each of them,
+  // their buffers must not be drawn before SubmitUploads. Batches can be nested, the outermost SubmitUploads copies
+  virtual void BeginUploads() = 0;
+  virtual void SubmitUploads() = 0;
+
+  // Freed ranges are only reused once no frame in flight can read them anymore, called once per frame
+  virtual void NextFrame() = 0;
+
+  virtual GeometryBufferStats GetStats() = 0;
+
+  // Allocations larger than a page get a page of their own
+  static ReferencePointer<GeometryBuffer> Create(const ReferencePointer<class RenderDevice>& device, size_t vertexPageSize = 64ULL * 1024 * 1024,
+                                                 size_t indexPageSize = 32ULL * 1024 * 1024);
+};
+}  // namespace Hydrogen
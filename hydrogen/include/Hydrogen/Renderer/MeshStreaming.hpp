@@ -0,0 +1,136 @@
+#pragma once
+
+#include <functional>
+#include <limits>
+#include <mutex>
+#include "../Core/Memory.hpp"
+#include "Buffer.hpp"
+
+namespace Hydrogen {
+// Vertices (packed in the vertex layout) and indices of the prefix one level of a streamed mesh is drawn from
+struct StreamedGeometry {
+  DynamicArray<uint8_t> Vertices;
+  DynamicArray<uint32_t> Indices;
+};
+
+// A mesh whose levels of detail are laid out coarsest first, so every level is drawn from a prefix of the vertices and of the indices and the
+// prefix of a level holds all coarser levels as well
+struct StreamedMeshDescription {
+  // Lengths of the prefixes
+  struct Level {
+    uint32_t VertexCount;
+    uint32_t IndexCount;
+  };
+
+  BufferLayout Layout;
+  uint32_t VertexStride = 0;
+  // Ordered from the full resolution mesh to the coarsest one, like MeshRendererComponent::SubMesh::Levels
+  DynamicArray<Level> Levels;
+  // Runs on a worker thread, the function has to keep the data it reads from alive itself
+  std::function<StreamedGeometry(uint32_t level)> ReadLevel;
+};
+
+struct MeshStreamingStats {
+  uint64_t Budget = 0;
+  // Resident and loading levels, including the coarsest levels
+  uint64_t ResidentBytes = 0;
+  uint32_t MeshCount = 0;
+  uint32_t PendingLoads = 0;
+  uint64_t LoadedLevels = 0;
+  uint64_t EvictedLevels = 0;
+};
+
+// Geometry buffer residency of one streamed mesh. The coarsest level is uploaded when the mesh is created and stays resident, one finer level at a
+// time is loaded and evicted by MeshStreaming::Update. The resident level is drawn from one vertex array, which also draws every coarser level
+class StreamedMesh {
+ public:
+  StreamedMesh(const StreamedMeshDescription& description, const ReferencePointer<class VertexArray>& coarsest);
+
+  // The finest resident level, draws of finer levels fall back to it until they are loaded
+  uint32_t GetResidentLevel() const { return m_ResidentLevel; }
+  const ReferencePointer<class VertexArray>& GetVertexArray() const { return m_Resident ? m_Resident : m_Coarsest; }
+
+  uint32_t GetCoarsestLevel() const { return static_cast<uint32_t>(m_Description.Levels.size() - 1); }
+  // Geometry buffer bytes of the prefix of the level
+  uint64_t GetLevelSize(uint32_t level) const;
+  uint64_t GetMemoryUsage() const { return GetLevelSize(GetCoarsestLevel()) + m_ResidentSize + m_PendingSize; }
+
+ private:
+  friend class MeshStreaming;
+
+  static constexpr uint32_t s_NoLevel = std::numeric_limits<uint32_t>::max();
+
+  // Keeps the finest level and the largest screen size requested by the instances in the frame
+  void Request(uint32_t level, float screenSize, uint64_t frame);
+  uint32_t GetRequestedLevel(uint64_t frame) const { return m_RequestFrame == frame ? m_RequestedLevel : GetCoarsestLevel(); }
+
+  StreamedMeshDescription m_Description;
+  ReferencePointer<class VertexArray> m_Coarsest;
+  // Empty while only the coarsest level is resident
+  ReferencePointer<class VertexArray> m_Resident;
+  uint32_t m_ResidentLevel;
+  uint64_t m_ResidentSize = 0;
+  uint32_t m_PendingLevel = s_NoLevel;
+  uint64_t m_PendingSize = 0;
+
+  uint32_t m_RequestedLevel = 0;
+  float m_ScreenSize = 0.0f;
+  uint64_t m_RequestFrame = 0;
+  // Last frame an instance needed the resident level
+  uint64_t m_UsedFrame = 0;
+};
+
+// Keeps the finer levels of detail of streamed meshes resident while instances need them, within a budget of geometry buffer memory. The levels are
+// prepared on workers and uploaded in one batch per frame, the meshes covering the most of the viewport are loaded first and the levels nobody
+// needs anymore are evicted, the least recently needed ones first
+class MeshStreaming {
+ public:
+  // The coarsest levels count against the budget but are never evicted
+  static void SetBudget(uint64_t bytes) { s_Budget = bytes; }
+  static uint64_t GetBudget() { return s_Budget; }
+  static void SetMaxPendingLoads(uint32_t count) { s_MaxPendingLoads = count; }
+
+  // Uploads the coarsest level on the calling thread, the geometry buffer has to be set (see Renderer::SetGeometryBuffer)
+  static ReferencePointer<StreamedMesh> CreateMesh(const StreamedMeshDescription& description);
+
+  // Called once per frame on the main thread after the levels of detail were selected and before drawing: uploads the finished levels, collects the
+  // levels the instances in the scene selected, evicts unneeded levels and starts loading the missing ones
+  static void Update(class Scene& scene);
+
+  static MeshStreamingStats GetStats() { return s_Stats; }
+
+  // Drops the loads and references held for the next frame, called after the jobs finished and before the geometry buffer is destroyed
+  static void Shutdown();
+
+ private:
+  struct CompletedLoad {
+    ReferencePointer<StreamedMesh> Mesh;
+    uint32_t Level;
+    DynamicArray<uint8_t> Vertices;
+    DynamicArray<uint8_t> Indices;
+    IndexType IndexFormat;
+  };
+
+  static ReferencePointer<class VertexArray> CreateVertexArray(const StreamedMeshDescription& description, const DynamicArray<uint8_t>& vertices,
+                                                               const DynamicArray<uint8_t>& indices, IndexType indexType);
+  static void InstallCompletedLoads();
+  static void StartLoad(const ReferencePointer<StreamedMesh>& mesh, uint32_t level);
+  // Falls back to the coarsest level, only for meshes whose instances need nothing finer. Returns the number of bytes given back
+  static uint64_t Evict(StreamedMesh& mesh);
+
+  static uint64_t s_Budget;
+  static uint32_t s_MaxPendingLoads;
+  // Levels finer than needed stay resident for this many frames, so a camera moving back and forth does not reload them
+  static constexpr uint64_t s_EvictionDelay = 120;
+
+  // Everything but the completed loads is only touched on the main thread
+  static DynamicArray<std::weak_ptr<StreamedMesh>> s_Meshes;
+  static DynamicArray<ReferencePointer<StreamedMesh>> s_ActiveMeshes;
+  static uint64_t s_Frame;
+  static uint32_t s_PendingLoads;
+  static MeshStreamingStats s_Stats;
+
+  static DynamicArray<CompletedLoad> s_CompletedLoads;
+  static std::mutex s_CompletedLoadsMutex;
+};
+}  // namespace Hydrogen
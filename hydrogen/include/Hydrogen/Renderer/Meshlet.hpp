@@ -0,0 +1,31 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include "../Core/Memory.hpp"
+
+namespace Hydrogen {
+// Small cluster of a mesh (at most 64 vertices and 124 triangles), its triangles are the index range [FirstIndex, FirstIndex + IndexCount)
+struct Meshlet {
+  uint32_t FirstIndex = 0;
+  uint32_t IndexCount = 0;
+  uint32_t VertexCount = 0;
+  // Object space bounding sphere
+  glm::vec3 Center = {0.0f, 0.0f, 0.0f};
+  float Radius = 0.0f;
+  // All triangles face away from a camera for which dot(Center - camera, ConeAxis) >= ConeCutoff * |Center - camera| + Radius, a cutoff of 1 never culls
+  glm::vec3 ConeAxis = {0.0f, 0.0f, 0.0f};
+  float ConeCutoff = 1.0f;
+};
+
+struct IndexRange {
+  uint32_t FirstIndex;
+  uint32_t IndexCount;
+};
+
+class MeshletCulling {
+ public:
+  // Appends the index ranges of the meshlets that intersect the frustum and face the camera, neighbouring visible meshlets are merged into one range.
+  // The camera position is in object space, i.e. transformed by the inverse model matrix
+  static void Cull(const DynamicArray<Meshlet>& meshlets, const glm::mat4& modelViewProjection, const glm::vec3& cameraPosition, DynamicArray<IndexRange>& ranges);
+};
+}  // namespace Hydrogen
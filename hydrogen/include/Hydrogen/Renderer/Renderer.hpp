@@ -3,6 +3,7 @@
 #include "../Renderer/RendererAPI.hpp"
 #include "../Core/Memory.hpp"
 #include "../Math/Math.hpp"
+#include "../Renderer/Meshlet.hpp"
 
 #include <tracy/tracy.hpp>
 
@@ -65,6 +66,9 @@ class Renderer {
   inline static RendererAPI::API GetAPI() { return RendererAPI::GetAPI(); }
 
   static void SetContext(ReferencePointer<class Context> context) { s_Context = context; }
+  // Meshes upload their vertices and indices into this buffer
+  static void SetGeometryBuffer(ReferencePointer<class GeometryBuffer> geometryBuffer) { s_GeometryBuffer = geometryBuffer; }
+  static const ReferencePointer<class GeometryBuffer>& GetGeometryBuffer() { return s_GeometryBuffer; }
   const ReferencePointer<class Framebuffer>& GetFramebuffer() { return m_Framebuffer; }
 
   template <typename T>
@@ -74,7 +78,17 @@ class Renderer {
   }
 
  private:
+  void CreateShader(const ReferencePointer<class ShaderAsset>& shaderAsset);
+  // Keeps a replaced GPU resource alive until no frame in flight can reference it anymore, instead of waiting for the device to go idle
+  void Retire(const ReferencePointer<void>& resource);
+
+  struct RetiredResource {
+    ReferencePointer<void> Resource;
+    uint32_t FramesLeft;
+  };
+
   static ReferencePointer<Context> s_Context;
+  static ReferencePointer<GeometryBuffer> s_GeometryBuffer;
   static uint32_t s_MaxFramesInFlight;
 
   const ScopePointer<class Scene>& m_Scene;
@@ -88,5 +102,10 @@ class Renderer {
 
   ReferencePointer<class UniformBuffer> m_UniformBuffer;
   ReferencePointer<class Texture2D> m_Texture;
+  ReferencePointer<class ShaderAsset> m_ShaderAsset;
+
+  DynamicArray<RetiredResource> m_RetiredResources;
+  DynamicArray<IndexRange> m_VisibleRanges;
+  DynamicArray<uint64_t> m_ReloadCallbacks;
 };
 }  // namespace Hydrogen
@@ -3,6 +3,7 @@
 #include <glslang/Include/ResourceLimits.h>
 #include <glslang/Include/glslang_c_interface.h>
 
+#include "../Core/Cache.hpp"
 #include "../Core/Memory.hpp"
 
 namespace Hydrogen {
@@ -16,9 +17,15 @@ class ShaderCompiler {
   ShaderCompiler(ShaderLanguage frontEnd, ShaderClient client, SpriVVersion spirvVersion, ShaderStage stage, uint32_t version);
   ~ShaderCompiler();
 
-  void AddShader(const String& source);
+  // Returns false and logs the glslang info log if the source does not preprocess or compile
+  bool AddShader(const String& source);
 
-  void Link();
+  // Key covering every setting that influences the generated SPIR-V, including the glslang version
+  CacheKey GetCacheKey() const;
+  static String GetToolchainVersion();
+
+  // Returns false and logs the glslang info log if the program does not link
+  bool Link();
   DynamicArray<uint32_t> GetSpriv();
 
  private:
@@ -28,6 +35,10 @@ class ShaderCompiler {
   uint32_t m_Version;
   glslang_target_client_version_t m_ShaderClientVersion;
   glslang_target_language_version_t m_SpirvVersion;
+  ShaderLanguage m_Language;
+  ShaderClient m_Client;
+  SpriVVersion m_SpirvTarget;
+  ShaderStage m_Stage;
   glslang_program_t* m_Program;
   DynamicArray<glslang_shader_t*> m_Shader;
 };
@@ -15,6 +15,10 @@ class VertexArray {
   virtual const DynamicArray<ReferencePointer<class VertexBuffer>>& GetVertexBuffers() const = 0;
   virtual const ReferencePointer<class IndexBuffer>& GetIndexBuffer() const = 0;
 
+  // Where the buffers start in their bound buffers, added to the index range and the indices of every draw
+  virtual uint32_t GetFirstIndex() const = 0;
+  virtual int32_t GetVertexOffset() const = 0;
+
   static ReferencePointer<class VertexArray> Create();
 };
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -7,6 +8,8 @@
 #include <glm/gtx/quaternion.hpp>
 
 #include "../Core/Memory.hpp"
+#include "../Renderer/MeshStreaming.hpp"
+#include "../Renderer/Meshlet.hpp"
 
 namespace Hydrogen {
 class Entity;
@@ -19,6 +22,7 @@ struct TagComponent {
 
   TagComponent(const String& name) : Name(name), Tag(""), UUID(0) {}
   TagComponent(const String& name, const String& tag) : Name(name), Tag(tag), UUID(0) {}
+  TagComponent(const String& name, const String& tag, uint64_t uuid) : Name(name), Tag(tag), UUID(uuid) {}
 
   String Name;
   String Tag;
@@ -64,6 +68,85 @@ struct MeshRendererComponent {
 
   MeshRendererComponent(MeshRendererComponent&) = default;
 
-  DynamicArray<ReferencePointer<class VertexArray>> VertexArrays;
+  // Range of the index buffer drawing one level of detail, the error is the object space distance to the full resolution mesh. The indices of the
+  // levels are stored coarsest first and the vertices in the order of their first use, so a level only references the first VertexCount vertices
+  struct LevelOfDetail {
+    uint32_t FirstIndex = 0;
+    uint32_t IndexCount = 0;
+    float Error = 0.0f;
+    uint32_t VertexCount = 0;
+  };
+
+  // Levels are ordered from the full resolution mesh to the coarsest one, there is always at least one
+  struct SubMesh {
+    // Empty for streamed submeshes, they draw from the vertex array of their stream
+    ReferencePointer<class VertexArray> VertexArray;
+    ReferencePointer<StreamedMesh> Stream;
+    DynamicArray<LevelOfDetail> Levels;
+    // Clusters of the full resolution level, empty if the submesh is not made of triangles
+    DynamicArray<Meshlet> Meshlets;
+
+    const LevelOfDetail& GetLevel(uint32_t level) const { return Levels[std::min<size_t>(level, Levels.size() - 1)]; }
+    // Streamed submeshes draw the finest resident level until the selected one is loaded
+    uint32_t GetResidentLevel(uint32_t level) const { return Stream ? std::max(level, Stream->GetResidentLevel()) : level; }
+    const ReferencePointer<class VertexArray>& GetVertexArray() const { return Stream ? Stream->GetVertexArray() : VertexArray; }
+  };
+
+  DynamicArray<SubMesh> SubMeshes;
+};
+
+// Object space bounds of the meshes of an entity, the world space bounds are refreshed from the world transform by Scene::UpdateBounds
+struct BoundsComponent {
+  BoundsComponent() = default;
+  ~BoundsComponent() = default;
+
+  BoundsComponent(BoundsComponent&) = default;
+
+  // The box is transformed by its center and extents (Arvo), so it stays tight under rotation instead of boxing the eight transformed corners
+  void UpdateWorldBounds(const glm::mat4& transform) {
+    auto center = glm::vec3(transform * glm::vec4((Min + Max) * 0.5f, 1.0f));
+    auto extent = (Max - Min) * 0.5f;
+    auto worldExtent = glm::abs(glm::vec3(transform[0])) * extent.x + glm::abs(glm::vec3(transform[1])) * extent.y + glm::abs(glm::vec3(transform[2])) * extent.z;
+    WorldMin = center - worldExtent;
+    WorldMax = center + worldExtent;
+
+    auto scale = std::max({glm::length(glm::vec3(transform[0])), glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2]))});
+    WorldCenter = glm::vec3(transform * glm::vec4(Center, 1.0f));
+    WorldRadius = Radius * scale;
+  }
+
+  glm::vec3 Min = {0.0f, 0.0f, 0.0f};
+  glm::vec3 Max = {0.0f, 0.0f, 0.0f};
+  glm::vec3 Center = {0.0f, 0.0f, 0.0f};
+  float Radius = 0.0f;
+
+  glm::vec3 WorldMin = {0.0f, 0.0f, 0.0f};
+  glm::vec3 WorldMax = {0.0f, 0.0f, 0.0f};
+  glm::vec3 WorldCenter = {0.0f, 0.0f, 0.0f};
+  float WorldRadius = 0.0f;
+};
+
+// Selected from the world space bounding sphere of the entity's BoundsComponent
+struct LODComponent {
+  LODComponent() = default;
+  ~LODComponent() = default;
+
+  LODComponent(LODComponent&) = default;
+
+  // Picks the level for the projected height of the bounding sphere relative to the viewport height. Switching to a coarser level waits until
+  // the screen size dropped the hysteresis fraction below its threshold, so objects resting at a threshold do not flicker between two levels
+  uint32_t Select(float screenSize) {
+    ScreenSize = screenSize;
+    while (Level > 0 && screenSize >= ScreenSizes[Level]) Level--;
+    while (Level + 1 < ScreenSizes.size() && screenSize < ScreenSizes[Level + 1] * (1.0f - Hysteresis)) Level++;
+    return Level;
+  }
+
+  // Level i is drawn below ScreenSizes[i], the entries are descending and the first one is never reached
+  DynamicArray<float> ScreenSizes;
+  float Hysteresis = 0.1f;
+  uint32_t Level = 0;
+  // Of the last selection, streamed meshes load the finer levels of the largest instances first
+  float ScreenSize = 0.0f;
 };
 }  // namespace Hydrogen
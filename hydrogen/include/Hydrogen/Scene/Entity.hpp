@@ -3,6 +3,7 @@
 #include "../Core/Assert.hpp"
 #include "Scene.hpp"
 #include <entt/entt.hpp>
+#include <glm/glm.hpp>
 
 namespace Hydrogen {
 class Entity {
@@ -21,6 +22,9 @@ class Entity {
   Entity CreateChild(const String& name);
   Entity CreateChild(const String& name, const String& tag);
 
+  // Transform of the entity combined with the transforms of all its parents
+  glm::mat4 GetWorldTransform();
+
   bool Exists() { return m_EntityHandle != entt::null; }
 
   template <typename T>
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <entt/entt.hpp>
+#include <glm/glm.hpp>
 #include "../Core/Memory.hpp"
 
 namespace Hydrogen {
@@ -15,16 +16,30 @@ class Scene {
 
   Entity CreateEntity(const String& name);
   Entity CreateEntity(const String& name, const String& tag);
+  DynamicArray<Entity> CreateEntities(const String& name, size_t count);
   void DestroyEntity(Entity entity);
 
   DynamicArray<Entity> GetEntities();
   DynamicArray<Entity> GetEntitiesByName(const String& name);
   DynamicArray<Entity> GetEntitiesByTag(const String& tag);
+  // Returns a null entity if no entity with the given UUID exists
+  Entity FindByUUID(uint64_t uuid);
+
+  // Transforms every BoundsComponent into world space, call after moving entities and before anything reading the world bounds
+  void UpdateBounds();
+
+  // Selects the level of detail of every LODComponent from the projected size of its world bounds, the projection is the camera's perspective projection
+  void UpdateLevelsOfDetail(const glm::vec3& cameraPosition, const glm::mat4& projection);
+  void UpdateLevelsOfDetail(class Camera& camera);
 
   const String& GetName() const { return m_Name; }
 
  private:
+  void OnTagComponentConstruct(entt::registry& registry, entt::entity entity);
+  void OnTagComponentDestroy(entt::registry& registry, entt::entity entity);
+
   String m_Name;
+  UnorderedMap<uint64_t, entt::entity> m_EntityIndex;
   entt::registry m_Registry;
 };
 }  // namespace Hydrogen
@@ -0,0 +1,182 @@
+#include <Hydrogen/Assets/AssetDependencyGraph.hpp>
+#include <Hydrogen/Assets/AssetFileSystem.hpp>
+#include <Hydrogen/Assets/AssetPack.hpp>
+#include <Hydrogen/Core/Cache.hpp>
+#include <Hydrogen/Core/Logger.hpp>
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <unordered_set>
+#include <tracy/Tracy.hpp>
+#include <yaml-cpp/yaml.h>
+
+using namespace Hydrogen;
+
+namespace Hydrogen::Utils {
+static constexpr uint32_t s_DependencyGraphVersion = 1;
+
+static void RemoveValue(DynamicArray<String>& values, const String& value) { values.erase(std::remove(values.begin(), values.end(), value), values.end()); }
+}  // namespace Hydrogen::Utils
+
+UnorderedMap<String, DynamicArray<String>> AssetDependencyGraph::s_Dependencies;
+UnorderedMap<String, DynamicArray<String>> AssetDependencyGraph::s_Dependents;
+bool AssetDependencyGraph::s_Dirty = false;
+std::mutex AssetDependencyGraph::s_Mutex;
+
+std::filesystem::path AssetDependencyGraph::GetFilepath() { return CacheFile::GetMetadataDirectory() / "dependencies.yaml"; }
+
+void AssetDependencyGraph::Load() {
+  ZoneScoped;
+
+  auto filepath = GetFilepath();
+  std::error_code error;
+
+  YAML::Node root;
+  try {
+    if (std::filesystem::exists(filepath, error)) {
+      root = YAML::LoadFile(filepath.string());
+    } else {
+      // Pre-cooked builds ship the graph next to the cooked artifacts, their keys depend on it
+      filepath = std::filesystem::path(CacheFile::s_PackDirectory) / CacheFile::s_MetadataDirectory / filepath.filename();
+      auto data = AssetFileSystem::ReadFile(filepath);
+      if (!data) return;
+      root = YAML::Load(String(data->begin(), data->end()));
+    }
+  } catch (const YAML::Exception& exception) {
+    HY_LOG_WARN("Failed to parse asset dependency graph {}: {}", filepath.string(), exception.what());
+    return;
+  }
+
+  if (!root["Version"] || root["Version"].as<uint32_t>() != Utils::s_DependencyGraphVersion) return;
+
+  std::lock_guard<std::mutex> lock(s_Mutex);
+  s_Dependencies.clear();
+  s_Dependents.clear();
+  for (const auto& asset : root["Assets"]) {
+    auto path = asset["Path"].as<String>();
+    for (const auto& dependency : asset["Dependencies"]) {
+      auto dependencyPath = dependency.as<String>();
+      s_Dependencies[path].push_back(dependencyPath);
+      s_Dependents[dependencyPath].push_back(path);
+    }
+  }
+  s_Dirty = false;
+
+  HY_LOG_DEBUG("Loaded asset dependency graph with {} assets", s_Dependencies.size());
+}
+
+void AssetDependencyGraph::Save() {
+  ZoneScoped;
+
+  YAML::Emitter out;
+  {
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    if (!s_Dirty) return;
+    s_Dirty = false;
+
+    // Sorted, so the file diffs cleanly between runs
+    DynamicArray<String> assets;
+    for (const auto& [asset, dependencies] : s_Dependencies) assets.push_back(asset);
+    std::sort(assets.begin(), assets.end());
+
+    out << YAML::BeginMap;
+    out << YAML::Key << "Version" << YAML::Value << Utils::s_DependencyGraphVersion;
+    out << YAML::Key << "Assets" << YAML::Value << YAML::BeginSeq;
+    for (const auto& asset : assets) {
+      out << YAML::BeginMap;
+      out << YAML::Key << "Path" << YAML::Value << asset;
+      out << YAML::Key << "Dependencies" << YAML::Value << YAML::BeginSeq;
+      for (const auto& dependency : s_Dependencies[asset]) out << dependency;
+      out << YAML::EndSeq;
+      out << YAML::EndMap;
+    }
+    out << YAML::EndSeq;
+    out << YAML::EndMap;
+  }
+
+  // Published through an atomic rename like the cache artifacts, concurrent readers never see a partial graph and concurrent writers never share a
+  // temporary file
+  auto filepath = GetFilepath();
+  auto temporaryFilepath = CacheFile::GetTemporaryFilepath(filepath);
+  std::error_code error;
+  std::filesystem::create_directories(filepath.parent_path(), error);
+
+  std::ofstream outfile(temporaryFilepath, std::ios::out | std::ios::trunc);
+  if (!outfile.is_open()) {
+    HY_LOG_WARN("Failed to open file {}!", temporaryFilepath.string());
+    return;
+  }
+  outfile << out.c_str();
+  outfile.close();
+
+  std::filesystem::rename(temporaryFilepath, filepath, error);
+  if (error) {
+    HY_LOG_WARN("Failed to write asset dependency graph {}: {}", filepath.string(), error.message());
+    std::filesystem::remove(temporaryFilepath, error);
+  }
+}
+
+void AssetDependencyGraph::SetDependencies(const std::filesystem::path& asset, const DynamicArray<std::filesystem::path>& dependencies) {
+  auto path = AssetPack::NormalizePath(asset);
+  DynamicArray<String> dependencyPaths;
+  for (const auto& dependency : dependencies) {
+    auto dependencyPath = AssetPack::NormalizePath(dependency);
+    if (dependencyPath != path && std::find(dependencyPaths.begin(), dependencyPaths.end(), dependencyPath) == dependencyPaths.end()) dependencyPaths.push_back(dependencyPath);
+  }
+  std::sort(dependencyPaths.begin(), dependencyPaths.end());
+
+  std::lock_guard<std::mutex> lock(s_Mutex);
+  auto& current = s_Dependencies[path];
+  if (current == dependencyPaths) return;
+
+  for (const auto& dependency : current) Utils::RemoveValue(s_Dependents[dependency], path);
+  for (const auto& dependency : dependencyPaths) s_Dependents[dependency].push_back(path);
+  current = std::move(dependencyPaths);
+  s_Dirty = true;
+}
+
+DynamicArray<std::filesystem::path> AssetDependencyGraph::GetDependencies(const std::filesystem::path& asset) {
+  std::lock_guard<std::mutex> lock(s_Mutex);
+  auto it = s_Dependencies.find(AssetPack::NormalizePath(asset));
+  if (it == s_Dependencies.end()) return {};
+  return DynamicArray<std::filesystem::path>(it->second.begin(), it->second.end());
+}
+
+DynamicArray<std::filesystem::path> AssetDependencyGraph::GetDependents(const std::filesystem::path& filepath) {
+  std::lock_guard<std::mutex> lock(s_Mutex);
+  auto it = s_Dependents.find(AssetPack::NormalizePath(filepath));
+  if (it == s_Dependents.end()) return {};
+  return DynamicArray<std::filesystem::path>(it->second.begin(), it->second.end());
+}
+
+DynamicArray<std::filesystem::path> AssetDependencyGraph::CollectDependents(const std::filesystem::path& filepath) {
+  ZoneScoped;
+
+  auto root = AssetPack::NormalizePath(filepath);
+  std::unordered_set<String> visited = {root};
+  DynamicArray<std::filesystem::path> dependents;
+  std::deque<String> pending = {root};
+
+  std::lock_guard<std::mutex> lock(s_Mutex);
+  while (!pending.empty()) {
+    auto current = pending.front();
+    pending.pop_front();
+
+    auto it = s_Dependents.find(current);
+    if (it == s_Dependents.end()) continue;
+
+    for (const auto& dependent : it->second) {
+      // Cycles (e.g. mutually including shaders) are visited once
+      if (!visited.insert(dependent).second) continue;
+      dependents.push_back(dependent);
+      pending.push_back(dependent);
+    }
+  }
+
+  return dependents;
+}
+
+bool AssetDependencyGraph::IsDirty() {
+  std::lock_guard<std::mutex> lock(s_Mutex);
+  return s_Dirty;
+}
@@ -0,0 +1,157 @@
+#include <Hydrogen/Assets/AssetFileSystem.hpp>
+#include <Hydrogen/Core/Logger.hpp>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <tracy/Tracy.hpp>
+
+using namespace Hydrogen;
+
+DynamicArray<ScopePointer<AssetPack>> AssetFileSystem::s_Packs;
+std::shared_mutex AssetFileSystem::s_PacksMutex;
+thread_local AssetFileSystem::ReadStats AssetFileSystem::s_ThreadReadStats;
+
+bool AssetFileSystem::Mount(const std::filesystem::path& packFilepath) {
+  ZoneScoped;
+
+  auto pack = NewScopePointer<AssetPack>(packFilepath);
+  if (!pack->IsValid()) {
+    HY_LOG_ERROR("Failed to mount asset pack {}", packFilepath.string());
+    return false;
+  }
+
+  std::unique_lock<std::shared_mutex> lock(s_PacksMutex);
+  s_Packs.insert(s_Packs.begin(), std::move(pack));
+  return true;
+}
+
+void AssetFileSystem::UnmountAll() {
+  std::unique_lock<std::shared_mutex> lock(s_PacksMutex);
+  s_Packs.clear();
+}
+
+bool AssetFileSystem::HasPacks() {
+  std::shared_lock<std::shared_mutex> lock(s_PacksMutex);
+  return !s_Packs.empty();
+}
+
+bool AssetFileSystem::Exists(const std::filesystem::path& filepath) {
+  {
+    std::shared_lock<std::shared_mutex> lock(s_PacksMutex);
+    for (const auto& pack : s_Packs) {
+      if (pack->Exists(filepath) || pack->IsDirectory(filepath)) return true;
+    }
+  }
+
+  std::error_code error;
+  return std::filesystem::exists(filepath, error);
+}
+
+bool AssetFileSystem::IsDirectory(const std::filesystem::path& filepath) {
+  {
+    std::shared_lock<std::shared_mutex> lock(s_PacksMutex);
+    for (const auto& pack : s_Packs) {
+      if (pack->IsDirectory(filepath)) return true;
+    }
+  }
+
+  std::error_code error;
+  return std::filesystem::is_directory(filepath, error);
+}
+
+uintmax_t AssetFileSystem::GetFileSize(const std::filesystem::path& filepath) {
+  {
+    std::shared_lock<std::shared_mutex> lock(s_PacksMutex);
+    for (const auto& pack : s_Packs) {
+      if (auto entry = pack->Find(filepath)) return entry->Size;
+    }
+  }
+
+  std::error_code error;
+  auto size = std::filesystem::file_size(filepath, error);
+  return error ? 0 : size;
+}
+
+std::optional<DynamicArray<char>> AssetFileSystem::ReadFile(const std::filesystem::path& filepath) {
+  ZoneScoped;
+
+  auto startTime = std::chrono::steady_clock::now();
+  auto data = ReadFileUntracked(filepath);
+  AddThreadReadStats(data ? data->size() : 0, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count());
+  return data;
+}
+
+AssetFileSystem::ReadStats AssetFileSystem::GetThreadReadStats() { return s_ThreadReadStats; }
+
+void AssetFileSystem::AddThreadReadStats(uint64_t bytes, uint64_t nanoseconds) {
+  s_ThreadReadStats.Bytes += bytes;
+  s_ThreadReadStats.Nanoseconds += nanoseconds;
+}
+
+std::optional<DynamicArray<char>> AssetFileSystem::ReadFileUntracked(const std::filesystem::path& filepath) {
+  {
+    std::shared_lock<std::shared_mutex> lock(s_PacksMutex);
+    for (const auto& pack : s_Packs) {
+      if (auto data = pack->Read(filepath)) return data;
+    }
+  }
+
+  std::ifstream infile(filepath, std::ios::in | std::ios::binary | std::ios::ate);
+  if (!infile.is_open()) return std::nullopt;
+
+  DynamicArray<char> data(static_cast<size_t>(infile.tellg()));
+  infile.seekg(0);
+  infile.read(data.data(), data.size());
+  if (!infile) return std::nullopt;
+  return data;
+}
+
+DynamicArray<std::filesystem::path> AssetFileSystem::ListDirectory(const std::filesystem::path& directory) {
+  DynamicArray<std::filesystem::path> files;
+  {
+    std::shared_lock<std::shared_mutex> lock(s_PacksMutex);
+    for (const auto& pack : s_Packs) {
+      auto packFiles = pack->ListDirectory(directory);
+      files.insert(files.end(), packFiles.begin(), packFiles.end());
+    }
+  }
+
+  std::error_code error;
+  for (const auto& dirEntry : std::filesystem::directory_iterator(directory, error)) {
+    if (dirEntry.is_regular_file(error)) files.push_back(AssetPack::NormalizePath(dirEntry.path()));
+  }
+
+  std::sort(files.begin(), files.end());
+  files.erase(std::unique(files.begin(), files.end()), files.end());
+  return files;
+}
+
+DynamicArray<std::filesystem::path> AssetFileSystem::ListFiles(const std::filesystem::path& directory) {
+  ZoneScoped;
+
+  auto prefix = AssetPack::NormalizePath(directory);
+  if (!prefix.empty() && prefix.back() != '/') prefix += '/';
+
+  DynamicArray<std::filesystem::path> files;
+  {
+    std::shared_lock<std::shared_mutex> lock(s_PacksMutex);
+    for (const auto& pack : s_Packs) {
+      for (uint32_t i = 0; i < pack->GetEntryCount(); i++) {
+        auto path = pack->GetEntryPath(pack->GetEntry(i));
+        if (path.compare(0, prefix.size(), prefix) == 0) files.emplace_back(path);
+      }
+    }
+  }
+
+  std::error_code error;
+  for (auto it = std::filesystem::recursive_directory_iterator(directory, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+    if (it->is_symlink(error))  // TODO: Maybe use symlinks too
+      continue;
+    if (it->is_regular_file(error)) files.push_back(AssetPack::NormalizePath(it->path()));
+  }
+
+  std::sort(files.begin(), files.end());
+  files.erase(std::unique(files.begin(), files.end()), files.end());
+  return files;
+}
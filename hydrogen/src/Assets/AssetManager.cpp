@@ -1,32 +1,584 @@
 #include <Hydrogen/Assets/AssetManager.hpp>
+#include <Hydrogen/Assets/AssetDependencyGraph.hpp>
+#include <Hydrogen/Assets/AssetFileSystem.hpp>
 #include <Hydrogen/Core/Logger.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <tracy/Tracy.hpp>
+#include <yaml-cpp/yaml.h>
 
 using namespace Hydrogen;
 
-std::unordered_map<std::filesystem::path, ReferencePointer<Asset>> AssetManager::s_Assets;
+namespace Hydrogen::Utils {
+// Assets loaded lazily change the dependency graph in bursts, writing it once per interval is enough
+static constexpr auto s_DependencyGraphSaveInterval = std::chrono::seconds(1);
+static std::chrono::steady_clock::time_point s_LastDependencyGraphSave;
+
+// A collection that could not get below the budget is only retried after this interval, unless more assets were loaded in the meantime
+static constexpr auto s_GarbageCollectionRetryInterval = std::chrono::seconds(1);
+static std::chrono::steady_clock::time_point s_LastGarbageCollection;
+static size_t s_LastGarbageCollectionUsage = 0;
+
+// Waits inside a load run other queued jobs on the same thread, including the loads of other assets. Their reads and time are totalled here so the
+// enclosing load only counts its own
+struct NestedLoads {
+  uint64_t ReadBytes = 0;
+  uint64_t ReadNanoseconds = 0;
+  double Milliseconds = 0.0;
+};
+static thread_local NestedLoads s_NestedLoads;
+
+struct LoadEntry {
+  std::filesystem::path Filepath;
+  AssetID ID;
+  ReferencePointer<Asset> Instance;
+  String Type;
+  uintmax_t Cost;
+  double Milliseconds;
+};
+
+static String GetAssetTypeName(const std::filesystem::path& filepath) {
+  auto extension = filepath.extension().string();
+  if (SpriteAsset::CheckFileExtensions(extension)) return "Sprite";
+  if (ShaderAsset::CheckFileExtensions(extension)) return "Shader";
+  if (MeshAsset::CheckFileExtensions(extension)) return "Mesh";
+  return "Unknown";
+}
+
+static const char* GetAssetTypeName(AssetType type) {
+  switch (type) {
+    case AssetType::Sprite:
+      return "Sprite";
+    case AssetType::Shader:
+      return "Shader";
+    case AssetType::Mesh:
+      return "Mesh";
+    default:
+      return "Unknown";
+  }
+}
+
+static const char* GetAssetStateName(Asset::AssetState state) {
+  switch (state) {
+    case Asset::AssetState::Loading:
+      return "Loading";
+    case Asset::AssetState::Loaded:
+      return "Loaded";
+    case Asset::AssetState::Failed:
+      return "Failed";
+    default:
+      return "Unloaded";
+  }
+}
+
+// The file size is a cheap proxy for decode time, shader directories count the size of all their stages
+static uintmax_t EstimateLoadCost(const std::filesystem::path& filepath, const String& type) {
+  if (type != "Shader") return AssetFileSystem::GetFileSize(filepath);
+
+  uintmax_t size = 0;
+  for (const auto& stage : AssetFileSystem::ListDirectory(filepath)) {
+    size += AssetFileSystem::GetFileSize(stage);
+  }
+  return size;
+}
+
+// Shaders are directories (e.g. assets/Raw.glsl/shader.vert), every other asset is a single file
+static std::filesystem::path GetAssetPath(const std::filesystem::path& filepath) {
+  std::filesystem::path assetPath;
+  for (const auto& component : filepath) {
+    assetPath /= component;
+    if (component.extension() == ".glsl") break;
+  }
+  return assetPath;
+}
+
+// Metadata-only scan, nothing is opened or decoded here. With a mounted pack this never touches the disk
+static DynamicArray<std::filesystem::path> ListAssetPaths(const std::filesystem::path& directory) {
+  DynamicArray<std::filesystem::path> assetPaths;
+  for (const auto& filepath : AssetFileSystem::ListFiles(directory)) {
+    auto assetPath = GetAssetPath(filepath);
+    if (assetPaths.empty() || assetPaths.back() != assetPath) assetPaths.push_back(assetPath);
+  }
+  return assetPaths;
+}
+
+// Group by type, then run the most expensive groups and assets first so the long tail does not end up on a single thread
+static void SortByLoadCost(DynamicArray<LoadEntry>& entries) {
+  UnorderedMap<String, uintmax_t> typeCosts;
+  for (const auto& entry : entries) typeCosts[entry.Type] += entry.Cost;
+  std::sort(entries.begin(), entries.end(), [&typeCosts](const LoadEntry& a, const LoadEntry& b) {
+    if (a.Type != b.Type) return typeCosts[a.Type] != typeCosts[b.Type] ? typeCosts[a.Type] > typeCosts[b.Type] : a.Type < b.Type;
+    return a.Cost > b.Cost;
+  });
+}
+
+static void LogLoadTimes(DynamicArray<LoadEntry>& entries) {
+  std::sort(entries.begin(), entries.end(), [](const LoadEntry& a, const LoadEntry& b) { return a.Milliseconds > b.Milliseconds; });
+  HY_LOG_INFO("{:>10} | {:>10} | {:<8} | {}", "Time (ms)", "Size (KiB)", "Type", "Asset");
+  for (const auto& entry : entries) {
+    HY_LOG_INFO("{:>10.2f} | {:>10} | {:<8} | {}", entry.Milliseconds, entry.Cost / 1024, entry.Type, entry.Filepath.string());
+  }
+}
+}  // namespace Hydrogen::Utils
+
+std::array<AssetManager::PathShard, AssetManager::s_ShardCount> AssetManager::s_PathShards;
+std::array<std::shared_mutex, AssetManager::s_ShardCount> AssetManager::s_SlotMutexes;
+std::array<std::atomic<AssetManager::AssetSlot*>, AssetManager::s_MaxSlotChunks> AssetManager::s_SlotChunks;
+DynamicArray<ScopePointer<AssetManager::AssetSlot[]>> AssetManager::s_SlotChunkStorage;
+std::mutex AssetManager::s_SlotChunkMutex;
+std::atomic<AssetID> AssetManager::s_NextAssetID = InvalidAssetID + 1;
+std::array<DynamicArray<AssetID>, static_cast<size_t>(AssetType::Count)> AssetManager::s_TypeAssets;
+std::mutex AssetManager::s_TypeAssetsMutex;
+std::atomic<uint64_t> AssetManager::s_AccessCounter = 0;
+size_t AssetManager::s_MemoryBudget = 1024ULL * 1024 * 1024;
+#if defined HY_RELEASE
+bool AssetManager::s_HotReload = false;
+#else
+bool AssetManager::s_HotReload = true;
+#endif
+ScopePointer<FileWatcher> AssetManager::s_Watcher;
+UnorderedMap<uint64_t, AssetManager::ReloadListener> AssetManager::s_ReloadListeners;
+uint64_t AssetManager::s_NextReloadListener = 1;
+UnorderedMap<AssetID, uint64_t> AssetManager::s_ReloadGenerations;
 
 void AssetManager::Init() {
-  for (const auto& dirEntry : std::filesystem::recursive_directory_iterator("assets")) {
-    if (dirEntry.is_directory() && dirEntry.path().extension().string() != ".glsl") continue;
-    if (dirEntry.is_symlink())  // TODO: Maybe use symlinks too
-      continue;
-
-    HY_LOG_DEBUG("Asset file found: {}", dirEntry.path().string());
-
-    auto filename = dirEntry.path();
-    auto extension = filename.extension().string();
-    if (SpriteAsset::CheckFileExtensions(extension)) {
-      auto ref = NewReferencePointer<SpriteAsset>();
-      if (ref->GetInfo().Preload) ref->Load(filename);
-      s_Assets[filename] = ref;
-    } else if (ShaderAsset::CheckFileExtensions(extension)) {
-      auto ref = NewReferencePointer<ShaderAsset>();
-      ref->Load(filename);
-      s_Assets[filename] = ref;
-    } else if (MeshAsset::CheckFileExtensions(extension)) {
-      auto ref = NewReferencePointer<MeshAsset>();
-      if (ref->GetInfo().Preload) ref->Load(filename);
-      s_Assets[filename] = ref;
+  ZoneScoped;
+  auto startTime = std::chrono::steady_clock::now();
+
+  if (std::filesystem::exists(s_DefaultPack)) AssetFileSystem::Mount(s_DefaultPack);
+  AssetDependencyGraph::Load();
+
+  DynamicArray<Utils::LoadEntry> entries;
+  for (const auto& filename : Utils::ListAssetPaths("assets")) {
+    HY_LOG_DEBUG("Asset file found: {}", filename.string());
+
+    auto id = GetAssetID(filename);
+    auto asset = FindOrCreateAsset(id, AssetType::Unknown);
+    if (!asset || !asset->GetInfo().Preload) continue;
+
+    auto type = Utils::GetAssetTypeName(filename);
+    entries.push_back({filename, id, asset, type, Utils::EstimateLoadCost(filename, type), 0.0});
+  }
+
+  Utils::SortByLoadCost(entries);
+
+  std::atomic<uint32_t> finished = 0;
+  auto count = static_cast<uint32_t>(entries.size());
+  JobSystem::Dispatch(count, [&entries, &finished, count](uint32_t index) {
+    auto& entry = entries[index];
+    auto assetStartTime = std::chrono::steady_clock::now();
+    JobSystem::Wait(RequestLoad(entry.Instance, entry.ID, false));
+    entry.Milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - assetStartTime).count();
+
+    auto done = ++finished;
+    HY_LOG_DEBUG("Preloaded asset {}/{} ({:.1f} ms): {}", done, count, entry.Milliseconds, entry.Filepath.string());
+  });
+
+  auto totalMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+  HY_LOG_INFO("Preloaded {} assets in {:.1f} ms on {} threads", count, totalMilliseconds, JobSystem::GetThreadCount() + 1);
+
+  Utils::LogLoadTimes(entries);
+
+  // The preload list held references, so nothing could be evicted while it was running
+  entries.clear();
+  CollectGarbage();
+
+  AssetDependencyGraph::Save();
+  Utils::s_LastDependencyGraphSave = std::chrono::steady_clock::now();
+
+  std::error_code error;
+  if (s_HotReload && std::filesystem::is_directory("assets", error)) s_Watcher = NewScopePointer<FileWatcher>("assets");
+}
+
+bool AssetManager::Cook(const std::filesystem::path& directory) {
+  ZoneScoped;
+  auto startTime = std::chrono::steady_clock::now();
+
+  AssetDependencyGraph::Load();
+
+  DynamicArray<Utils::LoadEntry> entries;
+  for (const auto& filename : Utils::ListAssetPaths(directory)) {
+    auto type = Utils::GetAssetTypeName(filename);
+    if (type == "Unknown") continue;
+    entries.push_back({filename, InvalidAssetID, nullptr, type, Utils::EstimateLoadCost(filename, type), 0.0});
+  }
+  Utils::SortByLoadCost(entries);
+
+  // The importers write their cooked artifacts as a side effect of loading. The instances are not registered, so each one is freed as soon as it is cooked
+  std::atomic<uint32_t> finished = 0;
+  std::atomic<uint32_t> failed = 0;
+  auto count = static_cast<uint32_t>(entries.size());
+  JobSystem::Dispatch(count, [&entries, &finished, &failed, count](uint32_t index) {
+    auto& entry = entries[index];
+    auto assetStartTime = std::chrono::steady_clock::now();
+    bool cooked = CreateAsset(entry.Filepath)->Load(entry.Filepath);
+    entry.Milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - assetStartTime).count();
+
+    auto done = ++finished;
+    if (!cooked) {
+      failed++;
+      HY_LOG_ERROR("Failed to cook asset {}/{}: {}", done, count, entry.Filepath.string());
+      return;
     }
+    HY_LOG_INFO("Cooked asset {}/{} ({:.1f} ms): {}", done, count, entry.Milliseconds, entry.Filepath.string());
+  });
+
+  auto totalMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+  HY_LOG_INFO("Cooked {} assets in {:.1f} ms on {} threads", count, totalMilliseconds, JobSystem::GetThreadCount() + 1);
+  Utils::LogLoadTimes(entries);
+
+  AssetDependencyGraph::Save();
+  if (failed > 0) HY_LOG_ERROR("Failed to cook {} of {} assets", failed.load(), count);
+  return failed == 0;
+}
+
+void AssetManager::Update() {
+  ZoneScoped;
+
+#if defined TRACY_ENABLE
+  // Running totals, GetStats would lock every asset and copy every path each frame
+  TracyPlot("Asset CPU Memory", static_cast<int64_t>(GetMemoryUsage()));
+  TracyPlot("Asset GPU Memory", static_cast<int64_t>(Asset::s_GPUBytes.load(std::memory_order_relaxed)));
+  TracyPlot("Loaded Assets", Asset::s_ResidentCount.load(std::memory_order_relaxed));
+#endif
+
+  auto now = std::chrono::steady_clock::now();
+  auto usage = GetMemoryUsage();
+  if (usage > s_MemoryBudget && (usage > Utils::s_LastGarbageCollectionUsage || now - Utils::s_LastGarbageCollection > Utils::s_GarbageCollectionRetryInterval)) {
+    CollectGarbage();
+    Utils::s_LastGarbageCollection = now;
+    Utils::s_LastGarbageCollectionUsage = GetMemoryUsage();
+  }
+
+  if (now - Utils::s_LastDependencyGraphSave > Utils::s_DependencyGraphSaveInterval && AssetDependencyGraph::IsDirty()) {
+    AssetDependencyGraph::Save();
+    Utils::s_LastDependencyGraphSave = now;
   }
+
+  if (!s_Watcher) return;
+
+  // A changed file invalidates the asset it belongs to and everything that was built from it (e.g. all shaders including it)
+  DynamicArray<std::filesystem::path> assetPaths;
+  auto addAssetPath = [&assetPaths](const std::filesystem::path& filepath) {
+    auto assetPath = Utils::GetAssetPath(filepath);
+    if (std::find(assetPaths.begin(), assetPaths.end(), assetPath) == assetPaths.end()) assetPaths.push_back(assetPath);
+  };
+
+  for (const auto& filepath : s_Watcher->Poll()) {
+    addAssetPath(filepath);
+    for (const auto& dependent : AssetDependencyGraph::CollectDependents(filepath)) {
+      addAssetPath(dependent);
+    }
+  }
+
+  for (const auto& assetPath : assetPaths) {
+    Reload(GetAssetID(assetPath));
+  }
+}
+
+uint64_t AssetManager::AddReloadCallback(const std::filesystem::path& filepath, const ReloadCallback& callback) {
+  auto id = s_NextReloadListener++;
+  s_ReloadListeners[id] = {GetAssetID(filepath), callback};
+  return id;
+}
+
+void AssetManager::RemoveReloadCallback(uint64_t id) { s_ReloadListeners.erase(id); }
+
+void AssetManager::Reload(AssetID id) {
+  // New files are registered by the next Get
+  auto current = FindAsset(id);
+  if (!current) return;
+
+  auto filepath = GetAssetPath(id);
+  bool listened = std::any_of(s_ReloadListeners.begin(), s_ReloadListeners.end(), [id](const auto& listener) { return listener.second.ID == id; });
+  // Nothing resident and nobody to notify, the next Get reads the new content anyway. A failed instance is replaced once the file loads again
+  if (!current->IsLoaded() && !current->HasFailed() && !listened) return;
+  if (!AssetFileSystem::Exists(filepath)) return;
+
+  HY_LOG_INFO("Reloading asset {}", filepath);
+
+  // The old asset stays in place and usable until the new one finished loading on a worker, and for good if the new content does not load
+  auto asset = CreateAsset(filepath);
+  auto generation = ++s_ReloadGenerations[id];
+  auto startTime = std::chrono::steady_clock::now();
+  RequestLoad(asset, id, true);
+
+  asset->OnLoaded([asset, id, filepath, generation, startTime]() {
+    // A newer edit of the same file is already being loaded
+    if (s_ReloadGenerations[id] != generation) return;
+
+    if (asset->HasFailed()) {
+      HY_LOG_ERROR("Failed to reload asset {}, keeping the current version", filepath);
+      return;
+    }
+
+    {
+      std::unique_lock<std::shared_mutex> lock(GetSlotMutex(id));
+      asset->m_LastAccess.store(++s_AccessCounter, std::memory_order_relaxed);
+      GetSlot(id).Instance = asset;
+    }
+
+    // Copied first, callbacks may add or remove listeners
+    DynamicArray<ReloadCallback> callbacks;
+    for (const auto& [listenerID, listener] : s_ReloadListeners) {
+      if (listener.ID == id) callbacks.push_back(listener.Callback);
+    }
+    for (const auto& callback : callbacks) {
+      callback(asset);
+    }
+
+    auto milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    HY_LOG_INFO("Reloaded asset {} in {:.1f} ms", filepath, milliseconds);
+  });
+}
+
+AssetID AssetManager::GetAssetID(const std::filesystem::path& filepath) {
+  auto path = AssetPack::NormalizePath(filepath);
+  auto& shard = s_PathShards[AssetPack::HashPath(path) % s_ShardCount];
+
+  {
+    std::shared_lock<std::shared_mutex> lock(shard.Mutex);
+    auto it = shard.IDs.find(path);
+    if (it != shard.IDs.end()) return it->second;
+  }
+
+  std::unique_lock<std::shared_mutex> lock(shard.Mutex);
+  auto it = shard.IDs.find(path);
+  if (it != shard.IDs.end()) return it->second;
+
+  auto id = s_NextAssetID++;
+  auto chunkIndex = id / s_SlotChunkSize;
+  HY_ASSERT(chunkIndex < s_MaxSlotChunks, "Too many asset paths, at most {} can be interned!", s_MaxSlotChunks * s_SlotChunkSize);
+
+  if (!s_SlotChunks[chunkIndex].load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> chunkLock(s_SlotChunkMutex);
+    if (!s_SlotChunks[chunkIndex].load(std::memory_order_relaxed)) {
+      s_SlotChunkStorage.push_back(NewScopePointer<AssetSlot[]>(s_SlotChunkSize));
+      s_SlotChunks[chunkIndex].store(s_SlotChunkStorage.back().get(), std::memory_order_release);
+    }
+  }
+
+  // Published before the ID is visible to any other thread
+  GetSlot(id).Filepath = path;
+  shard.IDs.emplace(path, id);
+  return id;
+}
+
+String AssetManager::GetAssetPath(AssetID id) {
+  if (id == InvalidAssetID || id >= s_NextAssetID.load()) return String();
+  return GetSlot(id).Filepath;
+}
+
+DynamicArray<AssetID> AssetManager::GetAssetIDs(AssetType type) {
+  std::lock_guard<std::mutex> lock(s_TypeAssetsMutex);
+  return s_TypeAssets[static_cast<size_t>(type)];
+}
+
+ReferencePointer<Asset> AssetManager::CreateAsset(const std::filesystem::path& filepath) {
+  auto extension = filepath.extension().string();
+  if (SpriteAsset::CheckFileExtensions(extension)) {
+    return NewReferencePointer<SpriteAsset>();
+  } else if (ShaderAsset::CheckFileExtensions(extension)) {
+    return NewReferencePointer<ShaderAsset>();
+  } else if (MeshAsset::CheckFileExtensions(extension)) {
+    return NewReferencePointer<MeshAsset>();
+  }
+
+  return nullptr;
+}
+
+ReferencePointer<Asset> AssetManager::FindAsset(AssetID id) {
+  if (id == InvalidAssetID) return nullptr;
+
+  std::shared_lock<std::shared_mutex> lock(GetSlotMutex(id));
+  return GetSlot(id).Instance;
+}
+
+ReferencePointer<Asset> AssetManager::FindOrCreateAsset(AssetID id, AssetType type) {
+  if (id == InvalidAssetID) return nullptr;
+  auto& slot = GetSlot(id);
+
+  ReferencePointer<Asset> asset;
+  {
+    std::shared_lock<std::shared_mutex> lock(GetSlotMutex(id));
+    asset = slot.Instance;
+  }
+
+  if (!asset) {
+    // Missing files never get a slot instance, so a later Get picks the file up once it exists
+    if (!AssetFileSystem::Exists(slot.Filepath)) return nullptr;
+
+    auto created = CreateAsset(slot.Filepath);
+    if (!created) return nullptr;
+
+    std::unique_lock<std::shared_mutex> lock(GetSlotMutex(id));
+    if (!slot.Instance) {
+      slot.Instance = created;
+      std::lock_guard<std::mutex> typeLock(s_TypeAssetsMutex);
+      s_TypeAssets[static_cast<size_t>(created->GetType())].push_back(id);
+    }
+    asset = slot.Instance;
+  }
+
+  asset->m_LastAccess.store(++s_AccessCounter, std::memory_order_relaxed);
+  if (type != AssetType::Unknown && asset->GetType() != type) return nullptr;
+  return asset;
+}
+
+std::shared_future<void> AssetManager::RequestLoad(const ReferencePointer<Asset>& asset, AssetID id, bool async) {
+  std::unique_lock<std::mutex> lock(asset->m_LoadMutex);
+  if (asset->m_State.load() != Asset::AssetState::Unloaded) return asset->m_LoadFuture;
+
+  auto promise = NewReferencePointer<std::promise<void>>();
+  asset->m_LoadFuture = promise->get_future().share();
+  asset->m_State.store(Asset::AssetState::Loading);
+  auto loadFuture = asset->m_LoadFuture;
+  lock.unlock();
+
+  auto job = [asset, filepath = GetAssetPath(id), promise]() {
+    ZoneScoped;
+    // Loads run start to end on one thread, so the reads of this thread in the meantime belong to the asset, except for the nested loads
+    auto readStats = AssetFileSystem::GetThreadReadStats();
+    auto nestedLoads = Utils::s_NestedLoads;
+    auto startTime = std::chrono::steady_clock::now();
+    bool loaded = asset->Load(filepath);
+    auto milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+    {
+      auto readBytes = AssetFileSystem::GetThreadReadStats().Bytes - readStats.Bytes;
+      auto readNanoseconds = AssetFileSystem::GetThreadReadStats().Nanoseconds - readStats.Nanoseconds;
+      const auto& nested = Utils::s_NestedLoads;
+      auto ioMilliseconds = static_cast<double>(readNanoseconds - (nested.ReadNanoseconds - nestedLoads.ReadNanoseconds)) / 1e6;
+      auto ownMilliseconds = milliseconds - (nested.Milliseconds - nestedLoads.Milliseconds);
+
+      std::lock_guard<std::mutex> statsLock(asset->m_StatsMutex);
+      asset->m_Stats.ReadBytes += readBytes - (nested.ReadBytes - nestedLoads.ReadBytes);
+      asset->m_Stats.IOMilliseconds += ioMilliseconds;
+      asset->m_Stats.DecodeMilliseconds += std::max(ownMilliseconds - ioMilliseconds, 0.0);
+      asset->m_Stats.LoadCount++;
+
+      // Everything since the start, including the loads nested in this one, is excluded from an enclosing load
+      Utils::s_NestedLoads = {nestedLoads.ReadBytes + readBytes, nestedLoads.ReadNanoseconds + readNanoseconds, nestedLoads.Milliseconds + milliseconds};
+    }
+
+    {
+      std::lock_guard<std::mutex> loadLock(asset->m_LoadMutex);
+      if (loaded) {
+        asset->SetResident(true);
+        asset->m_State.store(Asset::AssetState::Loaded, std::memory_order_release);
+      } else {
+        // Whatever was read before the error is dropped, Get returns nullptr for the failed instance until a reload replaces it
+        asset->Unload();
+        asset->m_State.store(Asset::AssetState::Failed, std::memory_order_release);
+        HY_LOG_ERROR("Failed to load asset {}", filepath);
+      }
+      for (auto& callback : asset->m_LoadCallbacks) {
+        JobSystem::ExecuteOnMainThread(callback);
+      }
+      asset->m_LoadCallbacks.clear();
+      promise->set_value();
+    }
+  };
+
+  if (async) {
+    JobSystem::Execute(job);
+  } else {
+    job();
+  }
+
+  return loadFuture;
+}
+
+DynamicArray<AssetStats> AssetManager::GetStats() {
+  ZoneScoped;
+
+  DynamicArray<AssetStats> stats;
+  for (size_t type = 0; type < s_TypeAssets.size(); type++) {
+    for (auto id : GetAssetIDs(static_cast<AssetType>(type))) {
+      auto asset = FindAsset(id);
+      auto loadStats = asset->GetLoadStats();
+      bool loaded = asset->IsLoaded();
+      // Minus the registry slot and the local copy
+      stats.push_back({id, GetAssetPath(id), asset->GetType(), asset->GetState(), loadStats.ReadBytes, loaded ? asset->GetMemoryUsage() : 0, loadStats.GPUBytes,
+                       loadStats.IOMilliseconds, loadStats.DecodeMilliseconds, loadStats.UploadMilliseconds, loadStats.LoadCount, asset.use_count() - 2});
+    }
+  }
+  return stats;
+}
+
+bool AssetManager::DumpStats(const std::filesystem::path& filepath) {
+  ZoneScoped;
+
+  // Flow style with quoted strings is valid JSON
+  YAML::Emitter out;
+  out.SetMapFormat(YAML::Flow);
+  out.SetSeqFormat(YAML::Flow);
+  out.SetStringFormat(YAML::DoubleQuoted);
+
+  out << YAML::BeginMap;
+  out << YAML::Key << "Assets" << YAML::Value << YAML::BeginSeq;
+  for (const auto& stats : GetStats()) {
+    out << YAML::BeginMap;
+    out << YAML::Key << "Path" << YAML::Value << stats.Filepath;
+    out << YAML::Key << "Type" << YAML::Value << Utils::GetAssetTypeName(stats.Type);
+    out << YAML::Key << "State" << YAML::Value << Utils::GetAssetStateName(stats.State);
+    out << YAML::Key << "ReadBytes" << YAML::Value << stats.ReadBytes;
+    out << YAML::Key << "CPUBytes" << YAML::Value << stats.CPUBytes;
+    out << YAML::Key << "GPUBytes" << YAML::Value << stats.GPUBytes;
+    out << YAML::Key << "IOMilliseconds" << YAML::Value << stats.IOMilliseconds;
+    out << YAML::Key << "DecodeMilliseconds" << YAML::Value << stats.DecodeMilliseconds;
+    out << YAML::Key << "UploadMilliseconds" << YAML::Value << stats.UploadMilliseconds;
+    out << YAML::Key << "LoadCount" << YAML::Value << stats.LoadCount;
+    out << YAML::Key << "ReferenceCount" << YAML::Value << stats.ReferenceCount;
+    out << YAML::EndMap;
+  }
+  out << YAML::EndSeq;
+  out << YAML::EndMap;
+
+  std::ofstream outfile(filepath, std::ios::out | std::ios::trunc);
+  if (!outfile.is_open()) {
+    HY_LOG_ERROR("Failed to open file {}!", filepath.string());
+    return false;
+  }
+  outfile << out.c_str() << std::endl;
+  return !outfile.fail();
+}
+
+size_t AssetManager::GetMemoryUsage() { return Asset::s_ResidentBytes.load(std::memory_order_relaxed); }
+
+size_t AssetManager::CollectGarbage() {
+  ZoneScoped;
+  if (GetMemoryUsage() <= s_MemoryBudget) return 0;
+
+  // Holding every shard keeps FindOrCreateAsset from handing out new references while candidates are unloaded
+  DynamicArray<std::unique_lock<std::shared_mutex>> locks;
+  for (auto& mutex : s_SlotMutexes) locks.emplace_back(mutex);
+
+  DynamicArray<Asset*> candidates;
+  for (size_t type = 0; type < s_TypeAssets.size(); type++) {
+    for (auto id : GetAssetIDs(static_cast<AssetType>(type))) {
+      const auto& asset = GetSlot(id).Instance;
+      if (asset->IsLoaded() && asset.use_count() == 1) candidates.push_back(asset.get());
+    }
+  }
+
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Asset* a, const Asset* b) { return a->m_LastAccess.load(std::memory_order_relaxed) < b->m_LastAccess.load(std::memory_order_relaxed); });
+
+  size_t freedSize = 0;
+  for (auto asset : candidates) {
+    if (GetMemoryUsage() <= s_MemoryBudget) break;
+
+    std::lock_guard<std::mutex> loadLock(asset->m_LoadMutex);
+    freedSize += asset->m_ResidentBytes;
+    asset->Unload();
+    asset->SetResident(false);
+    asset->m_State.store(Asset::AssetState::Unloaded, std::memory_order_release);
+    asset->m_LoadFuture = std::shared_future<void>();
+  }
+
+  if (freedSize > 0) HY_LOG_DEBUG("Unloaded {} bytes of assets, {} bytes resident", freedSize, GetMemoryUsage());
+  return freedSize;
 }
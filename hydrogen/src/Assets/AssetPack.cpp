@@ -0,0 +1,234 @@
+#include <Hydrogen/Assets/AssetPack.hpp>
+#include <Hydrogen/Core/Compression.hpp>
+#include <Hydrogen/Core/Hash.hpp>
+#include <Hydrogen/Core/Logger.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <tracy/Tracy.hpp>
+
+using namespace Hydrogen;
+
+namespace Hydrogen::Utils {
+static bool EntryLess(const PackEntry& entry, uint64_t hash, const char* strings, const String& path) {
+  if (entry.PathHash != hash) return entry.PathHash < hash;
+  return std::string_view(strings + entry.PathOffset, entry.PathLength) < path;
+}
+
+static uint64_t AlignUp(uint64_t value, uint64_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+}  // namespace Hydrogen::Utils
+
+String AssetPack::NormalizePath(const std::filesystem::path& filepath) { return filepath.lexically_normal().generic_string(); }
+
+uint64_t AssetPack::HashPath(const String& path) { return Hash::FNV1a(path.data(), path.size()); }
+
+AssetPack::AssetPack(const std::filesystem::path& filepath) : m_File(filepath) {
+  ZoneScoped;
+  if (!m_File.IsValid()) return;
+
+  auto data = m_File.GetData();
+  auto size = m_File.GetSize();
+
+  PackHeader header;
+  if (size < sizeof(header)) {
+    HY_LOG_ERROR("Asset pack {} is truncated", filepath.string());
+    return;
+  }
+  std::memcpy(&header, data, sizeof(header));
+
+  if (std::memcmp(header.Magic, s_Magic, sizeof(s_Magic)) != 0 || header.Version != s_Version) {
+    HY_LOG_ERROR("Asset pack {} has an unsupported format", filepath.string());
+    return;
+  }
+
+  if (header.TableOffset % alignof(PackEntry) != 0 || header.TableOffset > size || header.EntryCount > (size - header.TableOffset) / sizeof(PackEntry) ||
+      header.StringsOffset > size || header.StringsSize > size - header.StringsOffset) {
+    HY_LOG_ERROR("Asset pack {} has a corrupt table of contents", filepath.string());
+    return;
+  }
+
+  auto entries = reinterpret_cast<const PackEntry*>(data + header.TableOffset);
+  for (uint32_t i = 0; i < header.EntryCount; i++) {
+    const auto& entry = entries[i];
+    // Uncompressed entries are read and mapped with their Size, it must not reach past the stored bytes that were checked against the file
+    if (entry.Offset > size || entry.StoredSize > size - entry.Offset || static_cast<uint64_t>(entry.PathOffset) + entry.PathLength > header.StringsSize ||
+        (!(entry.Flags & PackEntryFlags_Compressed) && entry.Size != entry.StoredSize)) {
+      HY_LOG_ERROR("Asset pack {} has a corrupt table of contents", filepath.string());
+      return;
+    }
+  }
+
+  m_Strings = reinterpret_cast<const char*>(data + header.StringsOffset);
+  m_EntryCount = header.EntryCount;
+  m_Entries = entries;
+
+  for (uint32_t i = 0; i < m_EntryCount; i++) {
+    auto path = GetEntryPath(entries[i]);
+    for (auto separator = path.rfind('/'); separator != String::npos && separator > 0; separator = path.rfind('/', separator - 1)) {
+      m_DirectoryHashes.push_back(HashPath(path.substr(0, separator)));
+    }
+  }
+  std::sort(m_DirectoryHashes.begin(), m_DirectoryHashes.end());
+  m_DirectoryHashes.erase(std::unique(m_DirectoryHashes.begin(), m_DirectoryHashes.end()), m_DirectoryHashes.end());
+  HY_LOG_INFO("Mounted asset pack {} with {} entries", filepath.string(), m_EntryCount);
+}
+
+const PackEntry* AssetPack::Find(const std::filesystem::path& filepath) const {
+  if (!m_Entries) return nullptr;
+
+  auto path = NormalizePath(filepath);
+  auto hash = HashPath(path);
+  auto end = m_Entries + m_EntryCount;
+  auto it = std::lower_bound(m_Entries, end, hash, [this, &path](const PackEntry& entry, uint64_t value) { return Utils::EntryLess(entry, value, m_Strings, path); });
+  if (it == end || it->PathHash != hash || std::string_view(m_Strings + it->PathOffset, it->PathLength) != path) return nullptr;
+  return it;
+}
+
+bool AssetPack::IsDirectory(const std::filesystem::path& directory) const {
+  // A hash collision can at worst make an empty directory visible, listing it still returns the right files
+  return std::binary_search(m_DirectoryHashes.begin(), m_DirectoryHashes.end(), HashPath(NormalizePath(directory)));
+}
+
+const uint8_t* AssetPack::GetData(const PackEntry& entry) const {
+  if (entry.Flags & PackEntryFlags_Compressed) return nullptr;
+  return m_File.GetData() + entry.Offset;
+}
+
+std::optional<DynamicArray<char>> AssetPack::Read(const std::filesystem::path& filepath) const {
+  ZoneScoped;
+
+  auto entry = Find(filepath);
+  if (!entry) return std::nullopt;
+
+  DynamicArray<char> data(entry->Size);
+  auto stored = m_File.GetData() + entry->Offset;
+  if (entry->Flags & PackEntryFlags_Compressed) {
+    if (!Compression::Decompress(stored, entry->StoredSize, data.data(), data.size())) {
+      HY_LOG_ERROR("Failed to decompress {} from asset pack {}", filepath.string(), GetFilepath().string());
+      return std::nullopt;
+    }
+  } else if (entry->Size > 0) {
+    std::memcpy(data.data(), stored, entry->Size);
+  }
+
+  return data;
+}
+
+DynamicArray<std::filesystem::path> AssetPack::ListDirectory(const std::filesystem::path& directory) const {
+  auto prefix = NormalizePath(directory);
+  if (!prefix.empty() && prefix.back() != '/') prefix += '/';
+
+  DynamicArray<std::filesystem::path> files;
+  for (uint32_t i = 0; i < m_EntryCount; i++) {
+    std::string_view path(m_Strings + m_Entries[i].PathOffset, m_Entries[i].PathLength);
+    if (path.size() <= prefix.size() || path.compare(0, prefix.size(), prefix) != 0) continue;
+    if (path.find('/', prefix.size()) != std::string_view::npos) continue;
+    files.emplace_back(String(path));
+  }
+  return files;
+}
+
+DynamicArray<std::filesystem::path> AssetPack::ListFiles() const {
+  DynamicArray<std::filesystem::path> files;
+  files.reserve(m_EntryCount);
+  for (uint32_t i = 0; i < m_EntryCount; i++) {
+    files.emplace_back(GetEntryPath(m_Entries[i]));
+  }
+  return files;
+}
+
+void AssetPackWriter::AddFile(const std::filesystem::path& packPath, const std::filesystem::path& filepath) {
+  m_Files.push_back({AssetPack::NormalizePath(packPath), filepath});
+}
+
+void AssetPackWriter::AddDirectory(const std::filesystem::path& directory) {
+  for (const auto& dirEntry : std::filesystem::recursive_directory_iterator(directory)) {
+    if (!dirEntry.is_regular_file()) continue;
+    AddFile(dirEntry.path(), dirEntry.path());
+  }
+}
+
+bool AssetPackWriter::Write(const std::filesystem::path& filepath) {
+  ZoneScoped;
+
+  std::sort(m_Files.begin(), m_Files.end(), [](const PendingFile& a, const PendingFile& b) { return a.PackPath < b.PackPath; });
+  m_Files.erase(std::unique(m_Files.begin(), m_Files.end(), [](const PendingFile& a, const PendingFile& b) { return a.PackPath == b.PackPath; }), m_Files.end());
+
+  std::ofstream packfile(filepath, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!packfile.is_open()) {
+    HY_LOG_ERROR("Failed to open file {}!", filepath.string());
+    return false;
+  }
+
+  DynamicArray<PackEntry> entries;
+  String strings;
+  uint64_t offset = AssetPack::s_Alignment;
+  uint64_t storedTotal = 0;
+  uint64_t sizeTotal = 0;
+
+  for (const auto& file : m_Files) {
+    std::ifstream infile(file.Filepath, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!infile.is_open()) {
+      HY_LOG_ERROR("Failed to open file {}!", file.Filepath.string());
+      return false;
+    }
+    DynamicArray<char> data(static_cast<size_t>(infile.tellg()));
+    infile.seekg(0);
+    infile.read(data.data(), data.size());
+
+    PackEntry entry{};
+    entry.PathHash = AssetPack::HashPath(file.PackPath);
+    entry.Offset = offset;
+    entry.Size = data.size();
+    entry.PathOffset = static_cast<uint32_t>(strings.size());
+    entry.PathLength = static_cast<uint32_t>(file.PackPath.size());
+    strings += file.PackPath;
+
+    DynamicArray<uint8_t> compressed;
+    if (m_Compress && !data.empty()) compressed = Compression::Compress(data.data(), data.size());
+
+    // Payloads start on page boundaries, so uncompressed entries can be handed out straight from the mapping
+    packfile.seekp(static_cast<std::streamoff>(offset));
+    if (!compressed.empty() && compressed.size() <= data.size() - data.size() / 8) {
+      entry.Flags = PackEntryFlags_Compressed;
+      entry.StoredSize = compressed.size();
+      packfile.write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+    } else {
+      entry.StoredSize = data.size();
+      packfile.write(data.data(), data.size());
+    }
+
+    offset = Utils::AlignUp(offset + entry.StoredSize, AssetPack::s_Alignment);
+    storedTotal += entry.StoredSize;
+    sizeTotal += entry.Size;
+    entries.push_back(entry);
+  }
+
+  std::sort(entries.begin(), entries.end(), [&strings](const PackEntry& a, const PackEntry& b) {
+    if (a.PathHash != b.PathHash) return a.PathHash < b.PathHash;
+    return std::string_view(strings).substr(a.PathOffset, a.PathLength) < std::string_view(strings).substr(b.PathOffset, b.PathLength);
+  });
+
+  PackHeader header{};
+  std::memcpy(header.Magic, AssetPack::s_Magic, sizeof(header.Magic));
+  header.Version = AssetPack::s_Version;
+  header.EntryCount = static_cast<uint32_t>(entries.size());
+  header.TableOffset = entries.empty() ? sizeof(PackHeader) : offset;
+  header.StringsOffset = header.TableOffset + entries.size() * sizeof(PackEntry);
+  header.StringsSize = strings.size();
+
+  packfile.seekp(static_cast<std::streamoff>(header.TableOffset));
+  packfile.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(PackEntry));
+  packfile.write(strings.data(), strings.size());
+  packfile.seekp(0);
+  packfile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  packfile.close();
+
+  if (packfile.fail()) {
+    HY_LOG_ERROR("Failed to write file {}!", filepath.string());
+    return false;
+  }
+
+  HY_LOG_INFO("Wrote asset pack {} with {} entries ({} bytes, {} bytes stored)", filepath.string(), entries.size(), sizeTotal, storedTotal);
+  return true;
+}
@@ -0,0 +1,686 @@
+#include <Hydrogen/Assets/MeshAsset.hpp>
+#include <Hydrogen/Assets/AssetDependencyGraph.hpp>
+#include <Hydrogen/Assets/AssetFileSystem.hpp>
+#include <Hydrogen/Assets/SpriteAsset.hpp>
+#include <Hydrogen/Core/Assert.hpp>
+#include <Hydrogen/Core/JobSystem.hpp>
+#include <Hydrogen/Core/Logger.hpp>
+#include <Hydrogen/Core/Platform.hpp>
+#include <Hydrogen/Renderer/Renderer.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
+#include <assimp/IOSystem.hpp>
+#include <assimp/MemoryIOWrapper.h>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+
+#if defined HY_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined HY_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace Hydrogen;
+
+namespace Hydrogen::Utils {
+// Lets assimp resolve the mesh and its side files (e.g. .mtl) through the mounted asset packs
+class AssetIOSystem : public Assimp::IOSystem {
+ public:
+  bool Exists(const char* filepath) const override { return AssetFileSystem::Exists(filepath); }
+  char getOsSeparator() const override { return '/'; }
+
+  Assimp::IOStream* Open(const char* filepath, const char* mode = "rb") override {
+    if (std::strchr(mode, 'w') || std::strchr(mode, 'a')) return nullptr;
+
+    auto data = AssetFileSystem::ReadFile(filepath);
+    if (!data) return nullptr;
+    m_OpenedFiles.push_back(filepath);
+
+    auto buffer = new uint8_t[data->size()];
+    std::memcpy(buffer, data->data(), data->size());
+    return new Assimp::MemoryIOStream(buffer, data->size(), true);
+  }
+
+  void Close(Assimp::IOStream* stream) override { delete stream; }
+
+  // Every file the importer read, e.g. the mesh itself and its material libraries
+  const DynamicArray<std::filesystem::path>& GetOpenedFiles() const { return m_OpenedFiles; }
+
+ private:
+  DynamicArray<std::filesystem::path> m_OpenedFiles;
+};
+
+// The greedy meshlet order gives up most of the vertex cache order of the whole mesh, so every meshlet range is cache optimized again on its own
+static void OptimizeMeshletVertexCache(DynamicArray<uint32_t>& indices, const DynamicArray<Meshlet>& meshlets, uint32_t vertexCount) {
+  DynamicArray<uint32_t> localVertices(vertexCount, std::numeric_limits<uint32_t>::max());
+  DynamicArray<uint32_t> globalVertices;
+  DynamicArray<uint32_t> localIndices;
+  for (const auto& meshlet : meshlets) {
+    auto begin = indices.begin() + meshlet.FirstIndex;
+    auto end = begin + meshlet.IndexCount;
+
+    globalVertices.clear();
+    localIndices.clear();
+    for (auto index = begin; index != end; ++index) {
+      if (localVertices[*index] == std::numeric_limits<uint32_t>::max()) {
+        localVertices[*index] = static_cast<uint32_t>(globalVertices.size());
+        globalVertices.push_back(*index);
+      }
+      localIndices.push_back(localVertices[*index]);
+    }
+
+    MeshOptimizer::OptimizeVertexCache(localIndices, static_cast<uint32_t>(globalVertices.size()));
+    std::transform(localIndices.begin(), localIndices.end(), begin, [&globalVertices](uint32_t index) { return globalVertices[index]; });
+    for (auto vertex : globalVertices) localVertices[vertex] = std::numeric_limits<uint32_t>::max();
+  }
+}
+}  // namespace Hydrogen::Utils
+
+MeshVertexFormat MeshAsset::s_VertexFormat = MeshVertexFormat::Quantized;
+MeshLODSettings MeshAsset::s_LODSettings;
+
+BufferLayout MeshAsset::GetVertexLayout() {
+  if (s_VertexFormat == MeshVertexFormat::Quantized)
+    return {{ShaderDataType::Half4, "Position", false}, {ShaderDataType::Short2, "Normal", true}, {ShaderDataType::Half2, "TexCoords", false}};
+  return {{ShaderDataType::Float3, "Position", false}, {ShaderDataType::Float3, "Normal", false}, {ShaderDataType::Float2, "TexCoords", false}};
+}
+
+bool MeshAsset::Load(const std::filesystem::path& filepath) {
+  HY_ASSERT(!filepath.empty(),
+            "Parameter 'filepath' of type 'const String&' in function "
+            "MeshAsset::Load(const String& filepath) is an empty string!");
+  HY_LOG_INFO("Loading mesh asset '{}'!", filepath.string());
+  m_Filepath = filepath;
+
+  auto source = AssetFileSystem::ReadFile(filepath);
+  if (!source) {
+    HY_LOG_ERROR("Failed to read mesh file {}", m_Filepath.string());
+    return false;
+  }
+
+  auto settings = MeshImportSettings::Load(filepath);
+
+  // Hashing the sources is far cheaper than parsing them, so assimp only runs the first time a mesh, its dependencies or the importer setup change
+  CacheFile cache(m_Filepath.string() + ".mesh", GetCookKey(*source, AssetDependencyGraph::GetDependencies(filepath), settings));
+
+  if (auto cooked = cache.Read(); cooked && ReadCooked(*cooked)) {
+    HY_LOG_INFO("Finished loading mesh asset '{}' from cooked cache!", filepath.string());
+    return true;
+  }
+
+  Assimp::Importer importer;
+  auto ioSystem = new Utils::AssetIOSystem();
+  importer.SetIOHandler(ioSystem);
+  importer.SetPropertyInteger(AI_CONFIG_PP_RVC_FLAGS, settings.GetRemovedComponents());
+  const aiScene* scene = importer.ReadFile(m_Filepath.string(), settings.GetPostProcessFlags());
+  if (!scene || (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) || !scene->mRootNode) {
+    HY_LOG_ERROR("Failed to import mesh file {}: {}", m_Filepath.string(), importer.GetErrorString());
+    return false;
+  }
+
+  // The meshes only read their own aiMesh and write their own submesh, so they are converted in parallel with the same result as one after the other
+  m_SubMeshes = DynamicArray<SubMesh>(scene->mNumMeshes);
+  DynamicArray<VertexCacheStatistics> meshStatisticsBefore(scene->mNumMeshes);
+  DynamicArray<VertexCacheStatistics> meshStatisticsAfter(scene->mNumMeshes);
+  JobSystem::Dispatch(scene->mNumMeshes, [&](uint32_t i) {
+    // The optimizer works on float vertices, they are only packed into the vertex format at the end
+    DynamicArray<float> vertices;
+    auto& subMesh = m_SubMeshes[i];
+    subMesh = ConvertMesh(scene->mMeshes[i], vertices);
+    subMesh.Levels = {{0, static_cast<uint32_t>(subMesh.Indices.size()), 0.0f, static_cast<uint32_t>(vertices.size() / s_VertexFloatCount)}};
+    if (scene->mMeshes[i]->mPrimitiveTypes == aiPrimitiveType_TRIANGLE) OptimizeSubMesh(subMesh, vertices, meshStatisticsBefore[i], meshStatisticsAfter[i]);
+    PackVertices(subMesh, vertices);
+  });
+
+  VertexCacheStatistics statisticsBefore;
+  VertexCacheStatistics statisticsAfter;
+  for (uint32_t i = 0; i < scene->mNumMeshes; i++) {
+    statisticsBefore += meshStatisticsBefore[i];
+    statisticsAfter += meshStatisticsAfter[i];
+  }
+  HY_LOG_INFO("Optimized mesh '{}': ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}", filepath.string(), statisticsBefore.GetACMR(), statisticsAfter.GetACMR(),
+              statisticsBefore.GetATVR(), statisticsAfter.GetATVR());
+
+  m_Nodes.clear();
+  HandleNode(scene->mRootNode);
+
+  // Editing the import settings reimports the mesh like editing one of its sources
+  DynamicArray<std::filesystem::path> dependencies = ioSystem->GetOpenedFiles();
+  dependencies.push_back(MeshImportSettings::GetFilepath(filepath));
+  for (uint32_t i = 0; i < scene->mNumMaterials; i++) {
+    for (auto type : {aiTextureType_DIFFUSE, aiTextureType_SPECULAR, aiTextureType_NORMALS, aiTextureType_HEIGHT}) {
+      for (uint32_t j = 0; j < scene->mMaterials[i]->GetTextureCount(type); j++) {
+        aiString texturePath;
+        if (scene->mMaterials[i]->GetTexture(type, j, &texturePath) == aiReturn_SUCCESS) dependencies.push_back(m_Filepath.parent_path() / texturePath.C_Str());
+      }
+    }
+  }
+  AssetDependencyGraph::SetDependencies(filepath, dependencies);
+
+  importer.FreeScene();
+
+  // The dependencies are only known after the import, the artifact is published under the key the next load will compute
+  auto cooked = WriteCooked();
+  CacheFile(m_Filepath.string() + ".mesh", GetCookKey(*source, AssetDependencyGraph::GetDependencies(filepath), settings)).Write(cooked.data(), cooked.size());
+  HY_LOG_INFO("Finished loading mesh asset '{}'!", filepath.string());
+  return true;
+}
+
+void MeshAsset::Spawn(const ScopePointer<Scene>& scene, const String& name, bool streamed) {
+  HY_ASSERT(IsLoaded(), "MeshAsset '{}' not yet loaded!", m_Filepath.string());
+
+  auto startTime = std::chrono::steady_clock::now();
+  bool uploaded = false;
+  const auto& geometryBuffer = Renderer::GetGeometryBuffer();
+  HY_ASSERT(geometryBuffer, "No geometry buffer set for uploading mesh '{}'!", m_Filepath.string());
+
+  m_VertexArrays.resize(m_SubMeshes.size());
+  m_StreamedMeshes.resize(m_SubMeshes.size());
+  DynamicArray<MeshRendererComponent::SubMesh> subMeshes(m_SubMeshes.size());
+
+  // All submeshes are copied with one staging buffer and one submission
+  geometryBuffer->BeginUploads();
+  for (uint32_t i = 0; i < m_SubMeshes.size(); i++) {
+    const auto& subMesh = m_SubMeshes[i];
+    subMeshes[i].Levels = subMesh.Levels;
+    subMeshes[i].Meshlets = subMesh.Meshlets;
+
+    if (streamed && subMesh.Levels.size() > 1) {
+      subMeshes[i].Stream = m_StreamedMeshes[i].lock();
+      if (!subMeshes[i].Stream) {
+        subMeshes[i].Stream = MeshStreaming::CreateMesh(GetStreamedMeshDescription(i));
+        m_StreamedMeshes[i] = subMeshes[i].Stream;
+        uploaded = true;
+      }
+      continue;
+    }
+
+    if (!m_VertexArrays[i]) {
+      auto vertexBuffer = geometryBuffer->AllocateVertices(subMesh.Vertices.data(), subMesh.Vertices.size(), GetVertexStride());
+      vertexBuffer->SetLayout(GetVertexLayout());
+      auto indexBuffer = CreateIndexBuffer(geometryBuffer, subMesh);
+      m_VertexArrays[i] = VertexArray::Create();
+      m_VertexArrays[i]->AddVertexBuffer(vertexBuffer);
+      m_VertexArrays[i]->SetIndexBuffer(indexBuffer);
+      uploaded = true;
+    }
+    subMeshes[i].VertexArray = m_VertexArrays[i];
+  }
+  geometryBuffer->SubmitUploads();
+
+  if (uploaded) RecordUpload(GetGPUMemoryUsage(), std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count());
+
+  SpawnNode(0, name, scene, Entity(), subMeshes);
+}
+
+void MeshAsset::Unload() {
+  m_SubMeshes = DynamicArray<SubMesh>();
+  m_Nodes = DynamicArray<Node>();
+  m_VertexArrays.clear();
+  m_StreamedMeshes.clear();
+  RecordUpload(0, 0.0);
+}
+
+size_t MeshAsset::GetMemoryUsage() const {
+  size_t size = 0;
+  for (const auto& subMesh : m_SubMeshes) size += subMesh.Vertices.size() + subMesh.Indices.size() * sizeof(uint32_t);
+  return size + m_Nodes.size() * sizeof(Node);
+}
+
+MeshAsset::SubMesh MeshAsset::ConvertMesh(const aiMesh* mesh, DynamicArray<float>& vertices) {
+  SubMesh subMesh;
+  auto vertexCount = mesh->mNumVertices;
+  if (vertexCount == 0) return subMesh;
+
+  // Missing attributes read from a zeroed stream, so the interleaving loop stays branch free
+  DynamicArray<aiVector3D> zeros;
+  if (!mesh->mNormals || !mesh->mTextureCoords[0]) zeros.resize(vertexCount);
+  const aiVector3D* normals = mesh->mNormals ? mesh->mNormals : zeros.data();
+  const aiVector3D* texCoords = mesh->mTextureCoords[0] ? mesh->mTextureCoords[0] : zeros.data();
+
+  vertices.resize(static_cast<size_t>(vertexCount) * s_VertexFloatCount);
+  InterleaveVertices(vertices.data(), mesh->mVertices, normals, texCoords, vertexCount, subMesh.BoundsMin, subMesh.BoundsMax);
+
+  subMesh.BoundsCenter = (subMesh.BoundsMin + subMesh.BoundsMax) * 0.5f;
+  float radiusSquared = 0.0f;
+  for (uint32_t i = 0; i < vertexCount; i++) {
+    auto offset = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z) - subMesh.BoundsCenter;
+    radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+  }
+  subMesh.BoundsRadius = std::sqrt(radiusSquared);
+
+  // Triangulate leaves only points, lines and triangles, all faces of a triangle mesh have three indices
+  if (mesh->mPrimitiveTypes == aiPrimitiveType_TRIANGLE) {
+    subMesh.Indices.resize(static_cast<size_t>(mesh->mNumFaces) * 3);
+    uint32_t* indices = subMesh.Indices.data();
+    for (uint32_t i = 0; i < mesh->mNumFaces; i++, indices += 3) {
+      const uint32_t* face = mesh->mFaces[i].mIndices;
+      indices[0] = face[0];
+      indices[1] = face[1];
+      indices[2] = face[2];
+    }
+  } else {
+    size_t indexCount = 0;
+    for (uint32_t i = 0; i < mesh->mNumFaces; i++) indexCount += mesh->mFaces[i].mNumIndices;
+
+    subMesh.Indices.resize(indexCount);
+    uint32_t* indices = subMesh.Indices.data();
+    for (uint32_t i = 0; i < mesh->mNumFaces; i++) {
+      const aiFace& face = mesh->mFaces[i];
+      std::memcpy(indices, face.mIndices, face.mNumIndices * sizeof(uint32_t));
+      indices += face.mNumIndices;
+    }
+  }
+
+  return subMesh;
+}
+
+void MeshAsset::OptimizeSubMesh(SubMesh& subMesh, DynamicArray<float>& vertices, VertexCacheStatistics& statisticsBefore, VertexCacheStatistics& statisticsAfter) {
+  auto vertexCount = static_cast<uint32_t>(vertices.size() / s_VertexFloatCount);
+  statisticsBefore += MeshOptimizer::AnalyzeVertexCache(subMesh.Indices, vertexCount);
+
+  MeshOptimizer::OptimizeVertexCache(subMesh.Indices, vertexCount);
+  MeshOptimizer::OptimizeOverdraw(subMesh.Indices, vertices.data(), s_VertexFloatCount, vertexCount);
+  subMesh.Meshlets = MeshOptimizer::BuildMeshlets(subMesh.Indices, vertices.data(), s_VertexFloatCount, vertexCount);
+  Utils::OptimizeMeshletVertexCache(subMesh.Indices, subMesh.Meshlets, vertexCount);
+  BuildLevels(subMesh, vertices);
+  ReverseLevels(subMesh);
+  vertexCount = MeshOptimizer::OptimizeVertexFetch(vertices, s_VertexFloatCount, subMesh.Indices);
+
+  // The prefix of a level holds the coarser levels as well, so its vertex count is the largest index up to its end
+  uint32_t prefixVertexCount = 0;
+  for (auto level = subMesh.Levels.rbegin(); level != subMesh.Levels.rend(); ++level) {
+    auto end = subMesh.Indices.begin() + level->FirstIndex + level->IndexCount;
+    for (auto index = subMesh.Indices.begin() + level->FirstIndex; index != end; ++index) prefixVertexCount = std::max(prefixVertexCount, *index + 1);
+    level->VertexCount = prefixVertexCount;
+  }
+
+  const auto& fullLevel = subMesh.Levels[0];
+  statisticsAfter += MeshOptimizer::AnalyzeVertexCache(
+      DynamicArray<uint32_t>(subMesh.Indices.begin() + fullLevel.FirstIndex, subMesh.Indices.begin() + fullLevel.FirstIndex + fullLevel.IndexCount), vertexCount);
+}
+
+void MeshAsset::ReverseLevels(SubMesh& subMesh) {
+  DynamicArray<uint32_t> indices;
+  indices.reserve(subMesh.Indices.size());
+  for (auto level = subMesh.Levels.rbegin(); level != subMesh.Levels.rend(); ++level) {
+    auto firstIndex = static_cast<uint32_t>(indices.size());
+    indices.insert(indices.end(), subMesh.Indices.begin() + level->FirstIndex, subMesh.Indices.begin() + level->FirstIndex + level->IndexCount);
+    level->FirstIndex = firstIndex;
+  }
+
+  for (auto& meshlet : subMesh.Meshlets) meshlet.FirstIndex += subMesh.Levels[0].FirstIndex;
+  subMesh.Indices = std::move(indices);
+}
+
+void MeshAsset::BuildLevels(SubMesh& subMesh, const DynamicArray<float>& vertices) {
+  const auto& settings = s_LODSettings;
+  auto vertexCount = static_cast<uint32_t>(vertices.size() / s_VertexFloatCount);
+  auto radius = glm::length(subMesh.BoundsMax - subMesh.BoundsMin) * 0.5f;
+  const float attributeWeights[] = {settings.NormalWeight, settings.NormalWeight, settings.NormalWeight, settings.TexCoordWeight, settings.TexCoordWeight};
+
+  DynamicArray<uint32_t> previous = subMesh.Indices;
+  float error = 0.0f;
+  for (uint32_t level = 1; level < settings.MaxLevels && error < settings.MaxError * radius; level++) {
+    auto targetIndexCount = static_cast<size_t>(previous.size() / 3 * settings.Reduction) * 3;
+    float levelError = 0.0f;
+    auto indices = MeshOptimizer::Simplify(previous, vertices.data(), s_VertexFloatCount, vertexCount, attributeWeights, s_VertexFloatCount - 3, targetIndexCount,
+                                           settings.MaxError * radius - error, &levelError);
+
+    // Levels that barely differ from the previous one would cost memory without saving triangles
+    if (indices.empty() || indices.size() > previous.size() * s_MinLevelReduction) break;
+
+    error += levelError;
+    MeshOptimizer::OptimizeVertexCache(indices, vertexCount);
+    subMesh.Levels.push_back({static_cast<uint32_t>(subMesh.Indices.size()), static_cast<uint32_t>(indices.size()), error});
+    subMesh.Indices.insert(subMesh.Indices.end(), indices.begin(), indices.end());
+    previous = std::move(indices);
+  }
+}
+
+ReferencePointer<IndexBuffer> MeshAsset::CreateIndexBuffer(const ReferencePointer<GeometryBuffer>& geometryBuffer, const SubMesh& subMesh) {
+  if (subMesh.VertexCount > std::numeric_limits<uint16_t>::max())
+    return geometryBuffer->AllocateIndices(subMesh.Indices.data(), subMesh.Indices.size() * sizeof(uint32_t), IndexType::UInt32);
+
+  DynamicArray<uint16_t> indices(subMesh.Indices.size());
+  std::transform(subMesh.Indices.begin(), subMesh.Indices.end(), indices.begin(), [](uint32_t index) { return static_cast<uint16_t>(index); });
+  return geometryBuffer->AllocateIndices(indices.data(), indices.size() * sizeof(uint16_t), IndexType::UInt16);
+}
+
+size_t MeshAsset::GetGPUMemoryUsage() const {
+  size_t size = 0;
+  for (uint32_t i = 0; i < m_SubMeshes.size(); i++) {
+    if (m_VertexArrays[i]) {
+      const auto& indexBuffer = m_VertexArrays[i]->GetIndexBuffer();
+      size += m_SubMeshes[i].Vertices.size() + indexBuffer->GetCount() * Utils::IndexTypeSize(indexBuffer->GetIndexType());
+    }
+    if (auto streamedMesh = m_StreamedMeshes[i].lock()) size += streamedMesh->GetLevelSize(streamedMesh->GetCoarsestLevel());
+  }
+  return size;
+}
+
+StreamedMeshDescription MeshAsset::GetStreamedMeshDescription(uint32_t index) {
+  StreamedMeshDescription description;
+  description.Layout = GetVertexLayout();
+  description.VertexStride = GetVertexStride();
+  for (const auto& level : m_SubMeshes[index].Levels) description.Levels.push_back({level.VertexCount, level.FirstIndex + level.IndexCount});
+
+  description.ReadLevel = [asset = shared_from_this(), index](uint32_t level) {
+    const auto& subMesh = asset->m_SubMeshes[index];
+    const auto& prefix = subMesh.Levels[level];
+    StreamedGeometry geometry;
+    geometry.Vertices.assign(subMesh.Vertices.begin(), subMesh.Vertices.begin() + static_cast<size_t>(prefix.VertexCount) * GetVertexStride());
+    geometry.Indices.assign(subMesh.Indices.begin(), subMesh.Indices.begin() + prefix.FirstIndex + prefix.IndexCount);
+    return geometry;
+  };
+  return description;
+}
+
+void MeshAsset::PackVertices(SubMesh& subMesh, const DynamicArray<float>& vertices) {
+  subMesh.VertexCount = static_cast<uint32_t>(vertices.size() / s_VertexFloatCount);
+  subMesh.Vertices.resize(static_cast<size_t>(subMesh.VertexCount) * GetVertexStride());
+
+  if (s_VertexFormat == MeshVertexFormat::Float) {
+    std::memcpy(subMesh.Vertices.data(), vertices.data(), subMesh.Vertices.size());
+    return;
+  }
+
+  const float* in = vertices.data();
+  uint8_t* out = subMesh.Vertices.data();
+  for (uint32_t i = 0; i < subMesh.VertexCount; i++, in += s_VertexFloatCount, out += sizeof(QuantizedVertex)) {
+    QuantizedVertex vertex;
+    vertex.Position[0] = MeshOptimizer::QuantizeHalf(in[0]);
+    vertex.Position[1] = MeshOptimizer::QuantizeHalf(in[1]);
+    vertex.Position[2] = MeshOptimizer::QuantizeHalf(in[2]);
+    vertex.Position[3] = MeshOptimizer::QuantizeHalf(1.0f);
+
+    float normal[2];
+    MeshOptimizer::EncodeOctahedral(in + 3, normal);
+    vertex.Normal[0] = MeshOptimizer::QuantizeSnorm16(normal[0]);
+    vertex.Normal[1] = MeshOptimizer::QuantizeSnorm16(normal[1]);
+
+    vertex.TexCoords[0] = MeshOptimizer::QuantizeHalf(in[6]);
+    vertex.TexCoords[1] = MeshOptimizer::QuantizeHalf(in[7]);
+    std::memcpy(out, &vertex, sizeof(vertex));
+  }
+}
+
+void MeshAsset::InterleaveVertices(float* out, const aiVector3D* positions, const aiVector3D* normals, const aiVector3D* texCoords, uint32_t count, glm::vec3& boundsMin,
+                                   glm::vec3& boundsMax) {
+  uint32_t i = 0;
+  boundsMin = boundsMax = glm::vec3(positions[0].x, positions[0].y, positions[0].z);
+
+#if defined HY_SIMD_SSE2
+  // Unaligned 16 byte loads of the 12 byte vectors read one float past the element, so the last vertex is left to the scalar loop
+  __m128 minimum = _mm_set_ps(0.0f, positions[0].z, positions[0].y, positions[0].x);
+  __m128 maximum = minimum;
+  for (; i + 1 < count; i++, out += s_VertexFloatCount) {
+    __m128 position = _mm_loadu_ps(&positions[i].x);
+    __m128 normal = _mm_loadu_ps(&normals[i].x);
+    __m128 texCoord = _mm_loadu_ps(&texCoords[i].x);
+
+    // (px, py, pz, nx) and (ny, nz, u, v)
+    __m128 positionZNormalX = _mm_shuffle_ps(position, normal, _MM_SHUFFLE(0, 0, 2, 2));
+    _mm_storeu_ps(out, _mm_shuffle_ps(position, positionZNormalX, _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(out + 4, _mm_shuffle_ps(normal, texCoord, _MM_SHUFFLE(1, 0, 2, 1)));
+
+    minimum = _mm_min_ps(minimum, position);
+    maximum = _mm_max_ps(maximum, position);
+  }
+
+  alignas(16) float bounds[4];
+  _mm_store_ps(bounds, minimum);
+  boundsMin = glm::vec3(bounds[0], bounds[1], bounds[2]);
+  _mm_store_ps(bounds, maximum);
+  boundsMax = glm::vec3(bounds[0], bounds[1], bounds[2]);
+#elif defined HY_SIMD_NEON
+  // Same one float over-read as the SSE2 path
+  const float first[4] = {positions[0].x, positions[0].y, positions[0].z, 0.0f};
+  float32x4_t minimum = vld1q_f32(first);
+  float32x4_t maximum = minimum;
+  for (; i + 1 < count; i++, out += s_VertexFloatCount) {
+    float32x4_t position = vld1q_f32(&positions[i].x);
+    float32x4_t normal = vld1q_f32(&normals[i].x);
+    float32x4_t texCoord = vld1q_f32(&texCoords[i].x);
+
+    // (px, py, pz, nx) and (ny, nz, u, v)
+    vst1q_f32(out, vsetq_lane_f32(vgetq_lane_f32(normal, 0), position, 3));
+    vst1q_f32(out + 4, vcombine_f32(vget_low_f32(vextq_f32(normal, normal, 1)), vget_low_f32(texCoord)));
+
+    minimum = vminq_f32(minimum, position);
+    maximum = vmaxq_f32(maximum, position);
+  }
+
+  boundsMin = glm::vec3(vgetq_lane_f32(minimum, 0), vgetq_lane_f32(minimum, 1), vgetq_lane_f32(minimum, 2));
+  boundsMax = glm::vec3(vgetq_lane_f32(maximum, 0), vgetq_lane_f32(maximum, 1), vgetq_lane_f32(maximum, 2));
+#endif
+
+  for (; i < count; i++, out += s_VertexFloatCount) {
+    out[0] = positions[i].x;
+    out[1] = positions[i].y;
+    out[2] = positions[i].z;
+    out[3] = normals[i].x;
+    out[4] = normals[i].y;
+    out[5] = normals[i].z;
+    out[6] = texCoords[i].x;
+    out[7] = texCoords[i].y;
+
+    auto position = glm::vec3(positions[i].x, positions[i].y, positions[i].z);
+    boundsMin = glm::min(boundsMin, position);
+    boundsMax = glm::max(boundsMax, position);
+  }
+}
+
+CacheKey MeshAsset::GetCookKey(const DynamicArray<char>& source, const DynamicArray<std::filesystem::path>& dependencies, const MeshImportSettings& settings) {
+  CacheKey key;
+  key.Add(s_CookedVersion);
+  key.Add(settings);
+  key.Add(s_VertexFormat);
+  key.Add(s_LODSettings);
+  key.Add(source.data(), source.size());
+
+  for (const auto& dependency : dependencies) {
+    if (SpriteAsset::CheckFileExtensions(dependency.extension().string())) continue;
+
+    auto content = AssetFileSystem::ReadFile(dependency);
+    key.Add(dependency.generic_string());
+    key.Add(content.has_value());
+    if (content) key.Add(content->data(), content->size());
+  }
+
+  return key;
+}
+
+DynamicArray<char> MeshAsset::WriteCooked() const {
+  DynamicArray<char> data;
+  auto write = [&data](const void* value, size_t size) {
+    if (size) data.insert(data.end(), static_cast<const char*>(value), static_cast<const char*>(value) + size);
+  };
+
+  CookedHeader header = {{'H', 'Y', 'M', 'S'}, s_CookedVersion, static_cast<uint32_t>(m_SubMeshes.size()), static_cast<uint32_t>(m_Nodes.size()), s_VertexFormat};
+  write(&header, sizeof(header));
+
+  for (const auto& subMesh : m_SubMeshes) {
+    CookedSubMesh cookedSubMesh = {subMesh.VertexCount,
+                                   subMesh.Indices.size(),
+                                   subMesh.Levels.size(),
+                                   subMesh.Meshlets.size(),
+                                   {subMesh.BoundsMin.x, subMesh.BoundsMin.y, subMesh.BoundsMin.z},
+                                   {subMesh.BoundsMax.x, subMesh.BoundsMax.y, subMesh.BoundsMax.z},
+                                   {subMesh.BoundsCenter.x, subMesh.BoundsCenter.y, subMesh.BoundsCenter.z},
+                                   subMesh.BoundsRadius};
+    write(&cookedSubMesh, sizeof(cookedSubMesh));
+    write(subMesh.Vertices.data(), subMesh.Vertices.size());
+    write(subMesh.Indices.data(), subMesh.Indices.size() * sizeof(uint32_t));
+    write(subMesh.Levels.data(), subMesh.Levels.size() * sizeof(MeshRendererComponent::LevelOfDetail));
+    write(subMesh.Meshlets.data(), subMesh.Meshlets.size() * sizeof(Meshlet));
+  }
+
+  for (const auto& node : m_Nodes) {
+    CookedNode cookedNode = {static_cast<uint32_t>(node.Name.size()), static_cast<uint32_t>(node.Meshes.size()), static_cast<uint32_t>(node.Children.size())};
+    write(&cookedNode, sizeof(cookedNode));
+    write(node.Name.data(), node.Name.size());
+    write(node.Meshes.data(), node.Meshes.size() * sizeof(uint32_t));
+    write(node.Children.data(), node.Children.size() * sizeof(uint32_t));
+  }
+
+  return data;
+}
+
+bool MeshAsset::ReadCooked(const DynamicArray<char>& data) {
+  size_t offset = 0;
+  auto read = [&data, &offset](void* value, size_t size) {
+    if (size > data.size() - offset) return false;
+    if (size) std::memcpy(value, data.data() + offset, size);
+    offset += size;
+    return true;
+  };
+
+  CookedHeader header;
+  if (!read(&header, sizeof(header)) || std::memcmp(header.Magic, "HYMS", 4) != 0 || header.Version != s_CookedVersion || header.VertexFormat != s_VertexFormat)
+    return false;
+
+  // Every submesh and node takes at least its fixed size record, so damaged counts fail here instead of in the allocation
+  if (header.SubMeshCount > data.size() / sizeof(CookedSubMesh) || header.NodeCount > data.size() / sizeof(CookedNode)) return false;
+
+  DynamicArray<SubMesh> subMeshes(header.SubMeshCount);
+  for (auto& subMesh : subMeshes) {
+    CookedSubMesh cookedSubMesh;
+    if (!read(&cookedSubMesh, sizeof(cookedSubMesh))) return false;
+    if (cookedSubMesh.VertexCount > data.size() / GetVertexStride() || cookedSubMesh.IndexCount > data.size() / sizeof(uint32_t) ||
+        cookedSubMesh.LevelCount == 0 || cookedSubMesh.LevelCount > data.size() / sizeof(MeshRendererComponent::LevelOfDetail) ||
+        cookedSubMesh.MeshletCount > data.size() / sizeof(Meshlet))
+      return false;
+
+    subMesh.VertexCount = static_cast<uint32_t>(cookedSubMesh.VertexCount);
+    subMesh.Vertices.resize(static_cast<size_t>(cookedSubMesh.VertexCount) * GetVertexStride());
+    subMesh.Indices.resize(cookedSubMesh.IndexCount);
+    subMesh.Levels.resize(cookedSubMesh.LevelCount);
+    subMesh.Meshlets.resize(cookedSubMesh.MeshletCount);
+    if (!read(subMesh.Vertices.data(), subMesh.Vertices.size()) || !read(subMesh.Indices.data(), subMesh.Indices.size() * sizeof(uint32_t)) ||
+        !read(subMesh.Levels.data(), subMesh.Levels.size() * sizeof(MeshRendererComponent::LevelOfDetail)) ||
+        !read(subMesh.Meshlets.data(), subMesh.Meshlets.size() * sizeof(Meshlet)))
+      return false;
+
+    for (auto index : subMesh.Indices) {
+      if (index >= subMesh.VertexCount) return false;
+    }
+    for (const auto& level : subMesh.Levels) {
+      if (static_cast<uint64_t>(level.FirstIndex) + level.IndexCount > subMesh.Indices.size() || level.VertexCount > subMesh.VertexCount) return false;
+    }
+    const auto& fullLevel = subMesh.Levels[0];
+    for (const auto& meshlet : subMesh.Meshlets) {
+      if (meshlet.FirstIndex < fullLevel.FirstIndex || static_cast<uint64_t>(meshlet.FirstIndex) + meshlet.IndexCount > fullLevel.FirstIndex + fullLevel.IndexCount)
+        return false;
+    }
+    subMesh.BoundsMin = glm::vec3(cookedSubMesh.BoundsMin[0], cookedSubMesh.BoundsMin[1], cookedSubMesh.BoundsMin[2]);
+    subMesh.BoundsMax = glm::vec3(cookedSubMesh.BoundsMax[0], cookedSubMesh.BoundsMax[1], cookedSubMesh.BoundsMax[2]);
+    subMesh.BoundsCenter = glm::vec3(cookedSubMesh.BoundsCenter[0], cookedSubMesh.BoundsCenter[1], cookedSubMesh.BoundsCenter[2]);
+    subMesh.BoundsRadius = cookedSubMesh.BoundsRadius;
+  }
+
+  DynamicArray<Node> nodes(header.NodeCount);
+  for (auto& node : nodes) {
+    CookedNode cookedNode;
+    if (!read(&cookedNode, sizeof(cookedNode))) return false;
+    if (cookedNode.NameLength > data.size() || cookedNode.MeshCount > data.size() || cookedNode.ChildCount > data.size()) return false;
+
+    node.Name.resize(cookedNode.NameLength);
+    node.Meshes.resize(cookedNode.MeshCount);
+    node.Children.resize(cookedNode.ChildCount);
+    if (!read(node.Name.data(), node.Name.size()) || !read(node.Meshes.data(), node.Meshes.size() * sizeof(uint32_t)) ||
+        !read(node.Children.data(), node.Children.size() * sizeof(uint32_t)))
+      return false;
+
+    for (auto mesh : node.Meshes) {
+      if (mesh >= subMeshes.size()) return false;
+    }
+    // HandleNode writes the nodes in pre-order, children always come after their parent so SpawnNode can not recurse forever
+    auto index = static_cast<size_t>(&node - nodes.data());
+    for (auto child : node.Children) {
+      if (child <= index || child >= nodes.size()) return false;
+    }
+  }
+
+  if (nodes.empty()) return false;
+
+  m_SubMeshes = std::move(subMeshes);
+  m_Nodes = std::move(nodes);
+  return true;
+}
+
+uint32_t MeshAsset::HandleNode(const aiNode* node) {
+  auto index = static_cast<uint32_t>(m_Nodes.size());
+  m_Nodes.emplace_back();
+  m_Nodes[index].Name = node->mName.C_Str();
+  m_Nodes[index].Meshes.assign(node->mMeshes, node->mMeshes + node->mNumMeshes);
+
+  for (uint32_t i = 0; i < node->mNumChildren; i++) {
+    auto child = HandleNode(node->mChildren[i]);
+    m_Nodes[index].Children.push_back(child);
+  }
+
+  return index;
+}
+
+void MeshAsset::SpawnNode(uint32_t index, const String& name, const ScopePointer<Scene>& scene, Entity parent,
+                          const DynamicArray<MeshRendererComponent::SubMesh>& subMeshes) {
+  const auto& node = m_Nodes[index];
+  Entity entity;
+
+  if (parent.GetEntityHandle() != entt::null) {
+    entity = parent.CreateChild(node.Name);
+  } else {
+    entity = scene->CreateEntity(name);
+  }
+
+  if (!node.Meshes.empty()) {
+    auto& meshRenderer = entity.AddComponent<MeshRendererComponent>();
+    for (auto mesh : node.Meshes) meshRenderer.SubMeshes.push_back(subMeshes[mesh]);
+
+    const auto& bounds = AddBoundsComponent(entity, node);
+    AddLODComponent(entity, node, bounds.Radius);
+  }
+
+  for (auto child : node.Children) {
+    SpawnNode(child, name, scene, entity, subMeshes);
+  }
+}
+
+const BoundsComponent& MeshAsset::AddBoundsComponent(Entity entity, const Node& node) const {
+  auto& bounds = entity.AddComponent<BoundsComponent>();
+  bounds.Min = glm::vec3(std::numeric_limits<float>::max());
+  bounds.Max = glm::vec3(std::numeric_limits<float>::lowest());
+  for (auto mesh : node.Meshes) {
+    bounds.Min = glm::min(bounds.Min, m_SubMeshes[mesh].BoundsMin);
+    bounds.Max = glm::max(bounds.Max, m_SubMeshes[mesh].BoundsMax);
+  }
+
+  bounds.Center = (bounds.Min + bounds.Max) * 0.5f;
+  for (auto mesh : node.Meshes) bounds.Radius = std::max(bounds.Radius, glm::length(m_SubMeshes[mesh].BoundsCenter - bounds.Center) + m_SubMeshes[mesh].BoundsRadius);
+
+  bounds.UpdateWorldBounds(entity.GetWorldTransform());
+  return bounds;
+}
+
+void MeshAsset::AddLODComponent(Entity entity, const Node& node, float radius) const {
+  size_t levelCount = 1;
+  for (auto mesh : node.Meshes) levelCount = std::max(levelCount, m_SubMeshes[mesh].Levels.size());
+  if (levelCount == 1) return;
+
+  auto& lod = entity.AddComponent<LODComponent>();
+  lod.ScreenSizes.assign(levelCount, std::numeric_limits<float>::infinity());
+
+  for (size_t level = 1; level < levelCount; level++) {
+    float error = 0.0f;
+    for (auto mesh : node.Meshes) error = std::max(error, m_SubMeshes[mesh].Levels[std::min(level, m_SubMeshes[mesh].Levels.size() - 1)].Error);
+
+    // The diameter covers screenSize * height pixels, so an error of e covers e / Radius * screenSize * height / 2 pixels
+    auto threshold = error > 0.0f && radius > 0.0f ? 2.0f * s_LODPixelError * radius / (error * s_LODReferenceHeight) : std::numeric_limits<float>::infinity();
+    lod.ScreenSizes[level] = std::min(threshold, lod.ScreenSizes[level - 1]);
+  }
+}
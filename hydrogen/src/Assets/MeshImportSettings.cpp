@@ -0,0 +1,86 @@
+#include <Hydrogen/Assets/MeshImportSettings.hpp>
+#include <Hydrogen/Assets/AssetFileSystem.hpp>
+#include <Hydrogen/Core/Logger.hpp>
+#include <assimp/config.h>
+#include <assimp/postprocess.h>
+#include <yaml-cpp/yaml.h>
+#include <tracy/Tracy.hpp>
+
+using namespace Hydrogen;
+
+namespace Hydrogen::Utils {
+static constexpr const char* s_ImportSettingsExtension = ".meta";
+
+// Steps every import needs, the converter expects triangle lists with shared vertices and one primitive type per mesh
+static constexpr uint32_t s_RequiredPostProcessFlags = aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_SortByPType | aiProcess_RemoveComponent;
+
+// Nothing reads these, removing them early saves the work of the later steps on them
+static constexpr int s_UnusedComponents = aiComponent_TANGENTS_AND_BITANGENTS | aiComponent_COLORS | aiComponent_BONEWEIGHTS | aiComponent_ANIMATIONS | aiComponent_LIGHTS |
+                                          aiComponent_CAMERAS;
+
+static void ReadSetting(const YAML::Node& node, const char* key, bool& value) {
+  if (node && node[key]) value = node[key].as<bool>();
+}
+}  // namespace Hydrogen::Utils
+
+MeshImportSettings MeshImportSettings::GetPreset(const String& name) {
+  MeshImportSettings settings;
+  if (name == "Fast") {
+    settings.GenerateNormals = false;
+    settings.OptimizeMeshes = false;
+  } else if (name != "Default") {
+    HY_LOG_WARN("Unknown mesh import preset '{}', using the default one", name);
+  }
+  return settings;
+}
+
+MeshImportSettings MeshImportSettings::Load(const std::filesystem::path& assetFilepath) {
+  ZoneScoped;
+
+  auto filepath = GetFilepath(assetFilepath);
+  auto data = AssetFileSystem::ReadFile(filepath);
+  if (!data) return MeshImportSettings();
+
+  MeshImportSettings settings;
+  try {
+    auto root = YAML::Load(String(data->begin(), data->end()));
+    if (root["Preset"]) settings = GetPreset(root["Preset"].as<String>());
+
+    auto postProcess = root["PostProcess"];
+    Utils::ReadSetting(postProcess, "GenerateNormals", settings.GenerateNormals);
+    Utils::ReadSetting(postProcess, "OptimizeMeshes", settings.OptimizeMeshes);
+    Utils::ReadSetting(postProcess, "OptimizeGraph", settings.OptimizeGraph);
+    Utils::ReadSetting(postProcess, "FlipUVs", settings.FlipUVs);
+
+    auto attributes = root["Attributes"];
+    Utils::ReadSetting(attributes, "Normals", settings.Normals);
+    Utils::ReadSetting(attributes, "TexCoords", settings.TexCoords);
+  } catch (const YAML::Exception& exception) {
+    HY_LOG_WARN("Failed to parse mesh import settings {}: {}", filepath.string(), exception.what());
+    return MeshImportSettings();
+  }
+
+  return settings;
+}
+
+std::filesystem::path MeshImportSettings::GetFilepath(const std::filesystem::path& assetFilepath) {
+  auto filepath = assetFilepath;
+  filepath += Utils::s_ImportSettingsExtension;
+  return filepath;
+}
+
+uint32_t MeshImportSettings::GetPostProcessFlags() const {
+  uint32_t flags = Utils::s_RequiredPostProcessFlags;
+  if (GenerateNormals && Normals) flags |= aiProcess_GenSmoothNormals;
+  if (OptimizeMeshes) flags |= aiProcess_OptimizeMeshes;
+  if (OptimizeGraph) flags |= aiProcess_OptimizeGraph;
+  if (FlipUVs) flags |= aiProcess_FlipUVs;
+  return flags;
+}
+
+int MeshImportSettings::GetRemovedComponents() const {
+  int components = Utils::s_UnusedComponents;
+  if (!Normals) components |= aiComponent_NORMALS;
+  if (!TexCoords) components |= aiComponent_TEXCOORDS;
+  return components;
+}
@@ -0,0 +1,747 @@
+#include <Hydrogen/Assets/MeshOptimizer.hpp>
+#include <Hydrogen/Core/Assert.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+#include <glm/glm.hpp>
+#include <tracy/Tracy.hpp>
+
+using namespace Hydrogen;
+
+namespace Hydrogen::Utils {
+// Forsyth's tuning, the simulated cache is larger than the hardware one because the scores only approximate an LRU cache
+static constexpr uint32_t s_ForsythCacheSize = 32;
+static constexpr float s_CacheDecayPower = 1.5f;
+static constexpr float s_LastTriangleScore = 0.75f;
+static constexpr float s_ValenceBoostScale = 2.0f;
+static constexpr float s_ValenceBoostPower = 0.5f;
+static constexpr uint32_t s_MaxScoredValence = 64;
+
+// The overdraw pass finds its cluster boundaries with a FIFO cache like the one the hardware uses
+static constexpr uint32_t s_OverdrawCacheSize = 16;
+
+static constexpr uint32_t s_InvalidIndex = ~0u;
+
+struct ForsythScores {
+  // Indexed by cache position + 1, so vertices outside of the cache use entry 0
+  std::array<float, s_ForsythCacheSize + 1> Cache;
+  std::array<float, s_MaxScoredValence> Valence;
+
+  ForsythScores() {
+    Cache[0] = 0.0f;
+    for (uint32_t i = 0; i < s_ForsythCacheSize; i++) {
+      // The vertices of the last triangle get a fixed score, otherwise the order in which it was added would matter
+      Cache[i + 1] = i < 3 ? s_LastTriangleScore : std::pow(1.0f - static_cast<float>(i - 3) / (s_ForsythCacheSize - 3), s_CacheDecayPower);
+    }
+
+    Valence[0] = 0.0f;
+    for (uint32_t i = 1; i < s_MaxScoredValence; i++) {
+      Valence[i] = s_ValenceBoostScale * std::pow(static_cast<float>(i), -s_ValenceBoostPower);
+    }
+  }
+
+  float Get(int32_t cachePosition, uint32_t remainingTriangles) const {
+    if (remainingTriangles == 0) return -1.0f;
+    return Cache[cachePosition + 1] + Valence[std::min(remainingTriangles, s_MaxScoredValence - 1)];
+  }
+};
+
+// Returns the number of misses, FIFO semantics: a hit does not move the vertex to the front
+static uint32_t UpdateCache(const uint32_t* triangle, uint32_t cacheSize, DynamicArray<uint32_t>& timestamps, uint32_t& timestamp) {
+  uint32_t misses = 0;
+  for (uint32_t i = 0; i < 3; i++) {
+    if (timestamp - timestamps[triangle[i]] > cacheSize) {
+      timestamps[triangle[i]] = timestamp++;
+      misses++;
+    }
+  }
+  return misses;
+}
+
+static glm::vec3 GetPosition(const float* positions, uint32_t positionStride, uint32_t index) {
+  const float* position = positions + static_cast<size_t>(index) * positionStride;
+  return glm::vec3(position[0], position[1], position[2]);
+}
+
+// Position plus the weighted attributes, e.g. 8 for a normal and one set of texture coordinates
+static constexpr uint32_t s_MaxSimplifyDimensions = 8;
+
+// Collapses which would turn a triangle by more than this (cosine of the angle between the old and the new normal) are rejected
+static constexpr float s_MinCollapseNormalDot = 0.25f;
+
+using SimplifyPoint = std::array<double, s_MaxSimplifyDimensions>;
+
+// Garland and Heckbert's generalized quadric, the squared distance to a plane in n dimensions is p^T A p + 2 b^T p + c.
+// A is symmetric, only its upper triangle is stored
+struct Quadric {
+  std::array<double, s_MaxSimplifyDimensions*(s_MaxSimplifyDimensions + 1) / 2> A{};
+  SimplifyPoint B{};
+  double C = 0.0;
+  // Sum of the triangle areas, dividing by it turns the error back into a squared distance
+  double Weight = 0.0;
+
+  Quadric& operator+=(const Quadric& other) {
+    for (size_t i = 0; i < A.size(); i++) A[i] += other.A[i];
+    for (size_t i = 0; i < B.size(); i++) B[i] += other.B[i];
+    C += other.C;
+    Weight += other.Weight;
+    return *this;
+  }
+
+  double Evaluate(const SimplifyPoint& point, uint32_t dimensions) const {
+    double error = C;
+    for (uint32_t i = 0, k = 0; i < dimensions; i++) {
+      error += 2.0 * B[i] * point[i];
+      for (uint32_t j = i; j < dimensions; j++, k++) error += (i == j ? 1.0 : 2.0) * A[k] * point[i] * point[j];
+    }
+    return error;
+  }
+
+  // Plane spanned by the triangle, weighted by its area so that small triangles do not outweigh the large ones they border
+  static Quadric FromTriangle(const SimplifyPoint& p, const SimplifyPoint& q, const SimplifyPoint& r, uint32_t dimensions, double weight) {
+    Quadric quadric;
+    SimplifyPoint e1{};
+    SimplifyPoint e2{};
+
+    double length = 0.0;
+    for (uint32_t i = 0; i < dimensions; i++) length += (q[i] - p[i]) * (q[i] - p[i]);
+    if (length <= 0.0) return quadric;
+    length = std::sqrt(length);
+    for (uint32_t i = 0; i < dimensions; i++) e1[i] = (q[i] - p[i]) / length;
+
+    double projection = 0.0;
+    for (uint32_t i = 0; i < dimensions; i++) projection += e1[i] * (r[i] - p[i]);
+    length = 0.0;
+    for (uint32_t i = 0; i < dimensions; i++) {
+      e2[i] = r[i] - p[i] - projection * e1[i];
+      length += e2[i] * e2[i];
+    }
+    if (length <= 0.0) return quadric;
+    length = std::sqrt(length);
+    for (uint32_t i = 0; i < dimensions; i++) e2[i] /= length;
+
+    double pe1 = 0.0;
+    double pe2 = 0.0;
+    double pp = 0.0;
+    for (uint32_t i = 0; i < dimensions; i++) {
+      pe1 += p[i] * e1[i];
+      pe2 += p[i] * e2[i];
+      pp += p[i] * p[i];
+    }
+
+    for (uint32_t i = 0, k = 0; i < dimensions; i++) {
+      for (uint32_t j = i; j < dimensions; j++, k++) quadric.A[k] = weight * ((i == j ? 1.0 : 0.0) - e1[i] * e1[j] - e2[i] * e2[j]);
+      quadric.B[i] = weight * (pe1 * e1[i] + pe2 * e2[i] - p[i]);
+    }
+    quadric.C = weight * (pp - pe1 * pe1 - pe2 * pe2);
+    quadric.Weight = weight;
+    return quadric;
+  }
+};
+
+// Exact positions, -0 and 0 hash the same because they compare equal
+struct PositionHash {
+  size_t operator()(const glm::vec3& position) const {
+    size_t hash = 0;
+    for (uint32_t i = 0; i < 3; i++) {
+      float value = position[i] + 0.0f;
+      uint32_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      hash = hash * 0x9e3779b1u + bits;
+    }
+    return hash;
+  }
+};
+
+static glm::vec3 GetTriangleNormal(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) { return glm::cross(b - a, c - a); }
+
+// Cones wider than this (minimum cosine between the axis and a triangle normal) cull too rarely to be worth testing
+static constexpr float s_MinConeCosine = 0.1f;
+
+static void ComputeMeshletBounds(Meshlet& meshlet, const DynamicArray<uint32_t>& indices, const DynamicArray<uint32_t>& vertices, const float* positions,
+                                 uint32_t positionStride) {
+  glm::vec3 boundsMin = GetPosition(positions, positionStride, vertices[0]);
+  glm::vec3 boundsMax = boundsMin;
+  for (auto vertex : vertices) {
+    boundsMin = glm::min(boundsMin, GetPosition(positions, positionStride, vertex));
+    boundsMax = glm::max(boundsMax, GetPosition(positions, positionStride, vertex));
+  }
+
+  meshlet.Center = (boundsMin + boundsMax) * 0.5f;
+  meshlet.Radius = 0.0f;
+  for (auto vertex : vertices) meshlet.Radius = std::max(meshlet.Radius, glm::length(GetPosition(positions, positionStride, vertex) - meshlet.Center));
+
+  // The cone axis averages the unit normals, so a few large triangles do not hide the orientation of many small ones
+  DynamicArray<glm::vec3> normals;
+  normals.reserve(meshlet.IndexCount / 3);
+  glm::vec3 axis(0.0f);
+  for (uint32_t i = meshlet.FirstIndex; i < meshlet.FirstIndex + meshlet.IndexCount; i += 3) {
+    auto normal = GetTriangleNormal(GetPosition(positions, positionStride, indices[i]), GetPosition(positions, positionStride, indices[i + 1]),
+                                    GetPosition(positions, positionStride, indices[i + 2]));
+    auto length = glm::length(normal);
+    if (length <= 0.0f) continue;
+    normals.push_back(normal / length);
+    axis += normals.back();
+  }
+
+  meshlet.ConeAxis = glm::vec3(0.0f);
+  meshlet.ConeCutoff = 1.0f;
+  auto axisLength = glm::length(axis);
+  if (normals.empty() || axisLength <= 0.0f) return;
+  axis /= axisLength;
+
+  float minCosine = 1.0f;
+  for (const auto& normal : normals) minCosine = std::min(minCosine, glm::dot(normal, axis));
+  if (minCosine <= s_MinConeCosine) return;
+
+  // A view direction more than 90 degrees away from every normal sees only back faces, i.e. dot(view, axis) >= sin of the cone's half angle
+  meshlet.ConeAxis = axis;
+  meshlet.ConeCutoff = std::sqrt(1.0f - minCosine * minCosine);
+}
+}  // namespace Hydrogen::Utils
+
+VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(const DynamicArray<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize) {
+  VertexCacheStatistics statistics;
+  statistics.TriangleCount = indices.size() / 3;
+
+  DynamicArray<uint32_t> timestamps(vertexCount, 0);
+  uint32_t timestamp = cacheSize + 1;
+  for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+    statistics.TransformedVertices += Utils::UpdateCache(&indices[i], cacheSize, timestamps, timestamp);
+  }
+
+  DynamicArray<bool> referenced(vertexCount, false);
+  for (auto index : indices) {
+    if (!referenced[index]) statistics.VertexCount++;
+    referenced[index] = true;
+  }
+
+  return statistics;
+}
+
+void MeshOptimizer::OptimizeVertexCache(DynamicArray<uint32_t>& indices, uint32_t vertexCount) {
+  ZoneScoped;
+
+  static const Utils::ForsythScores scores;
+  auto triangleCount = static_cast<uint32_t>(indices.size() / 3);
+  if (triangleCount == 0) return;
+
+  // Vertex to triangle adjacency, the remaining triangles of a vertex are kept at the front of its range
+  DynamicArray<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+  for (auto index : indices) adjacencyOffsets[index + 1]++;
+  for (uint32_t i = 0; i < vertexCount; i++) adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+
+  DynamicArray<uint32_t> adjacency(indices.size());
+  DynamicArray<uint32_t> remainingTriangles(vertexCount, 0);
+  for (uint32_t i = 0; i < triangleCount * 3; i++) {
+    auto vertex = indices[i];
+    adjacency[adjacencyOffsets[vertex] + remainingTriangles[vertex]++] = i / 3;
+  }
+
+  DynamicArray<int32_t> cachePositions(vertexCount, -1);
+  DynamicArray<float> vertexScores(vertexCount);
+  for (uint32_t i = 0; i < vertexCount; i++) vertexScores[i] = scores.Get(-1, remainingTriangles[i]);
+
+  DynamicArray<float> triangleScores(triangleCount);
+  for (uint32_t i = 0; i < triangleCount; i++) {
+    triangleScores[i] = vertexScores[indices[i * 3]] + vertexScores[indices[i * 3 + 1]] + vertexScores[indices[i * 3 + 2]];
+  }
+
+  DynamicArray<bool> emitted(triangleCount, false);
+  DynamicArray<uint32_t> result;
+  result.reserve(indices.size());
+
+  std::array<uint32_t, Utils::s_ForsythCacheSize + 3> cache;
+  std::array<uint32_t, Utils::s_ForsythCacheSize + 3> newCache;
+  uint32_t cacheCount = 0;
+  uint32_t scanCursor = 0;
+  auto bestTriangle = static_cast<uint32_t>(std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+
+  auto updateVertexScore = [&](uint32_t vertex, int32_t cachePosition) {
+    cachePositions[vertex] = cachePosition;
+    auto score = scores.Get(cachePosition, remainingTriangles[vertex]);
+    auto delta = score - vertexScores[vertex];
+    vertexScores[vertex] = score;
+    for (uint32_t i = 0; i < remainingTriangles[vertex]; i++) triangleScores[adjacency[adjacencyOffsets[vertex] + i]] += delta;
+  };
+
+  for (uint32_t emittedCount = 0; emittedCount < triangleCount; emittedCount++) {
+    if (bestTriangle == Utils::s_InvalidIndex) {
+      // No cached vertex has triangles left, continue with the next triangle in input order
+      while (emitted[scanCursor]) scanCursor++;
+      bestTriangle = scanCursor;
+    }
+
+    emitted[bestTriangle] = true;
+    const uint32_t* triangle = &indices[bestTriangle * 3];
+    result.insert(result.end(), triangle, triangle + 3);
+
+    uint32_t newCacheCount = 0;
+    for (uint32_t i = 0; i < 3; i++) {
+      auto vertex = triangle[i];
+      auto begin = adjacency.begin() + adjacencyOffsets[vertex];
+      auto end = begin + remainingTriangles[vertex];
+      std::iter_swap(std::find(begin, end, bestTriangle), end - 1);
+      remainingTriangles[vertex]--;
+
+      // Degenerate triangles reference a vertex twice
+      if (std::find(newCache.begin(), newCache.begin() + newCacheCount, vertex) == newCache.begin() + newCacheCount) newCache[newCacheCount++] = vertex;
+    }
+    for (uint32_t i = 0; i < cacheCount; i++) {
+      if (cache[i] != triangle[0] && cache[i] != triangle[1] && cache[i] != triangle[2]) newCache[newCacheCount++] = cache[i];
+    }
+
+    for (uint32_t i = Utils::s_ForsythCacheSize; i < newCacheCount; i++) updateVertexScore(newCache[i], -1);
+    cacheCount = std::min(newCacheCount, Utils::s_ForsythCacheSize);
+    std::copy(newCache.begin(), newCache.begin() + cacheCount, cache.begin());
+
+    for (uint32_t i = 0; i < cacheCount; i++) updateVertexScore(cache[i], static_cast<int32_t>(i));
+
+    bestTriangle = Utils::s_InvalidIndex;
+    float bestScore = -1.0f;
+    for (uint32_t i = 0; i < cacheCount; i++) {
+      auto vertex = cache[i];
+      for (uint32_t j = 0; j < remainingTriangles[vertex]; j++) {
+        auto candidate = adjacency[adjacencyOffsets[vertex] + j];
+        if (triangleScores[candidate] > bestScore) {
+          bestScore = triangleScores[candidate];
+          bestTriangle = candidate;
+        }
+      }
+    }
+  }
+
+  indices = std::move(result);
+}
+
+void MeshOptimizer::OptimizeOverdraw(DynamicArray<uint32_t>& indices, const float* positions, uint32_t positionStride, uint32_t vertexCount, float threshold) {
+  ZoneScoped;
+
+  auto triangleCount = static_cast<uint32_t>(indices.size() / 3);
+  if (triangleCount == 0) return;
+
+  constexpr uint32_t cacheSize = Utils::s_OverdrawCacheSize;
+  DynamicArray<uint32_t> timestamps(vertexCount, 0);
+  uint32_t timestamp = cacheSize + 1;
+
+  // A triangle that misses the cache with all of its vertices starts a new, usually disjoint, patch of the mesh
+  DynamicArray<uint32_t> hardBoundaries;
+  for (uint32_t i = 0; i < triangleCount; i++) {
+    if (Utils::UpdateCache(&indices[i * 3], cacheSize, timestamps, timestamp) == 3 || i == 0) hardBoundaries.push_back(i);
+  }
+
+  // Patches are split further as long as each part stays within the threshold of the ACMR of the whole patch
+  DynamicArray<uint32_t> clusters;
+  for (size_t i = 0; i < hardBoundaries.size(); i++) {
+    auto start = hardBoundaries[i];
+    auto end = i + 1 < hardBoundaries.size() ? hardBoundaries[i + 1] : triangleCount;
+
+    timestamp += cacheSize + 1;
+    uint32_t misses = 0;
+    for (auto j = start; j < end; j++) misses += Utils::UpdateCache(&indices[j * 3], cacheSize, timestamps, timestamp);
+    float clusterThreshold = threshold * static_cast<float>(misses) / (end - start);
+
+    timestamp += cacheSize + 1;
+    clusters.push_back(start);
+    uint32_t runningMisses = 0;
+    uint32_t runningTriangles = 0;
+    for (auto j = start; j < end; j++) {
+      runningMisses += Utils::UpdateCache(&indices[j * 3], cacheSize, timestamps, timestamp);
+      runningTriangles++;
+
+      if (j + 1 < end && static_cast<float>(runningMisses) / runningTriangles <= clusterThreshold) {
+        clusters.push_back(j + 1);
+        timestamp += cacheSize + 1;
+        runningMisses = 0;
+        runningTriangles = 0;
+      }
+    }
+
+    // The tail never reached the target ACMR on its own, it is merged into the previous part
+    if (runningTriangles > 0 && clusters.back() != start) clusters.pop_back();
+  }
+
+  glm::vec3 meshCentroid(0.0f);
+  for (auto index : indices) meshCentroid += Utils::GetPosition(positions, positionStride, index);
+  meshCentroid /= static_cast<float>(indices.size());
+
+  // Clusters facing away from the mesh center are likely in front of the rest, whatever the view direction
+  DynamicArray<float> sortKeys(clusters.size());
+  for (size_t i = 0; i < clusters.size(); i++) {
+    auto start = clusters[i];
+    auto end = i + 1 < clusters.size() ? clusters[i + 1] : triangleCount;
+
+    glm::vec3 centroid(0.0f);
+    glm::vec3 normal(0.0f);
+    float area = 0.0f;
+    for (auto j = start; j < end; j++) {
+      auto a = Utils::GetPosition(positions, positionStride, indices[j * 3]);
+      auto b = Utils::GetPosition(positions, positionStride, indices[j * 3 + 1]);
+      auto c = Utils::GetPosition(positions, positionStride, indices[j * 3 + 2]);
+      auto triangleNormal = glm::cross(b - a, c - a);
+      auto triangleArea = glm::length(triangleNormal);
+
+      centroid += (a + b + c) / 3.0f * triangleArea;
+      normal += triangleNormal;
+      area += triangleArea;
+    }
+
+    auto normalLength = glm::length(normal);
+    sortKeys[i] = area > 0.0f && normalLength > 0.0f ? glm::dot(centroid / area - meshCentroid, normal / normalLength) : 0.0f;
+  }
+
+  DynamicArray<uint32_t> order(clusters.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&sortKeys](uint32_t a, uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+  DynamicArray<uint32_t> result;
+  result.reserve(indices.size());
+  for (auto cluster : order) {
+    auto start = clusters[cluster];
+    auto end = cluster + 1 < clusters.size() ? clusters[cluster + 1] : triangleCount;
+    result.insert(result.end(), indices.begin() + start * 3, indices.begin() + end * 3);
+  }
+
+  indices = std::move(result);
+}
+
+uint32_t MeshOptimizer::OptimizeVertexFetch(DynamicArray<float>& vertices, uint32_t vertexFloatCount, DynamicArray<uint32_t>& indices) {
+  ZoneScoped;
+
+  auto vertexCount = static_cast<uint32_t>(vertices.size() / vertexFloatCount);
+  DynamicArray<uint32_t> remap(vertexCount, Utils::s_InvalidIndex);
+  DynamicArray<float> result(vertices.size());
+
+  uint32_t nextVertex = 0;
+  for (auto& index : indices) {
+    if (remap[index] == Utils::s_InvalidIndex) {
+      remap[index] = nextVertex;
+      std::memcpy(result.data() + static_cast<size_t>(nextVertex) * vertexFloatCount, vertices.data() + static_cast<size_t>(index) * vertexFloatCount,
+                  vertexFloatCount * sizeof(float));
+      nextVertex++;
+    }
+    index = remap[index];
+  }
+
+  result.resize(static_cast<size_t>(nextVertex) * vertexFloatCount);
+  vertices = std::move(result);
+  return nextVertex;
+}
+
+uint16_t MeshOptimizer::QuantizeHalf(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  uint32_t sign = (bits >> 16) & 0x8000;
+  uint32_t magnitude = bits & 0x7fffffff;
+
+  // Rebias the exponent from 127 to 15 and round the mantissa at the 13th bit
+  uint32_t half = (magnitude - (112u << 23) + (1u << 12)) >> 13;
+  if (magnitude < (113u << 23)) half = 0;
+  if (magnitude >= (143u << 23)) half = 0x7c00;
+  if (magnitude > (255u << 23)) half = 0x7e00;
+
+  return static_cast<uint16_t>(sign | half);
+}
+
+int16_t MeshOptimizer::QuantizeSnorm16(float value) { return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f)); }
+
+void MeshOptimizer::EncodeOctahedral(const float* normal, float* encoded) {
+  float length = std::abs(normal[0]) + std::abs(normal[1]) + std::abs(normal[2]);
+  if (length == 0.0f) {
+    // Meshes without normals use a zero vector, it decodes to +z
+    encoded[0] = encoded[1] = 0.0f;
+    return;
+  }
+
+  float x = normal[0] / length;
+  float y = normal[1] / length;
+  if (normal[2] < 0.0f) {
+    // The lower half is folded over the diagonals of the square
+    float foldedX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+    float foldedY = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+    x = foldedX;
+    y = foldedY;
+  }
+
+  encoded[0] = x;
+  encoded[1] = y;
+}
+
+DynamicArray<uint32_t> MeshOptimizer::Simplify(const DynamicArray<uint32_t>& indices, const float* vertices, uint32_t vertexFloatCount, uint32_t vertexCount,
+                                               const float* attributeWeights, uint32_t attributeCount, size_t targetIndexCount, float targetError, float* resultError) {
+  ZoneScoped;
+
+  auto dimensions = 3 + attributeCount;
+  HY_ASSERT(dimensions <= Utils::s_MaxSimplifyDimensions && dimensions <= vertexFloatCount, "Too many attributes for the simplifier ({})", attributeCount);
+
+  DynamicArray<Utils::SimplifyPoint> points(vertexCount);
+  for (uint32_t i = 0; i < vertexCount; i++) {
+    const float* vertex = vertices + static_cast<size_t>(i) * vertexFloatCount;
+    for (uint32_t j = 0; j < dimensions; j++) points[i][j] = vertex[j] * (j < 3 ? 1.0 : attributeWeights[j - 3]);
+  }
+
+  // Vertices sharing a position (attribute seams) and vertices on open borders are never moved, collapsing one side of a seam would tear the mesh apart
+  DynamicArray<uint32_t> positionIDs(vertexCount);
+  {
+    std::unordered_map<glm::vec3, uint32_t, Utils::PositionHash> positions;
+    positions.reserve(vertexCount);
+    for (uint32_t i = 0; i < vertexCount; i++) positionIDs[i] = positions.emplace(Utils::GetPosition(vertices, vertexFloatCount, i), i).first->second;
+  }
+
+  DynamicArray<bool> locked(vertexCount, false);
+  {
+    DynamicArray<uint32_t> wedgeCount(vertexCount, 0);
+    for (uint32_t i = 0; i < vertexCount; i++) wedgeCount[positionIDs[i]]++;
+
+    DynamicArray<std::pair<uint32_t, uint32_t>> edges;
+    edges.reserve(indices.size());
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+      for (uint32_t j = 0; j < 3; j++) edges.emplace_back(positionIDs[indices[i + j]], positionIDs[indices[i + (j + 1) % 3]]);
+    }
+    std::sort(edges.begin(), edges.end());
+
+    DynamicArray<bool> borderPositions(vertexCount, false);
+    for (const auto& edge : edges) {
+      if (!std::binary_search(edges.begin(), edges.end(), std::make_pair(edge.second, edge.first))) borderPositions[edge.first] = borderPositions[edge.second] = true;
+    }
+    for (uint32_t i = 0; i < vertexCount; i++) locked[i] = wedgeCount[positionIDs[i]] > 1 || borderPositions[positionIDs[i]];
+  }
+
+  DynamicArray<Utils::Quadric> quadrics(vertexCount);
+  for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+    auto a = indices[i], b = indices[i + 1], c = indices[i + 2];
+    auto normal = Utils::GetTriangleNormal(Utils::GetPosition(vertices, vertexFloatCount, a), Utils::GetPosition(vertices, vertexFloatCount, b),
+                                           Utils::GetPosition(vertices, vertexFloatCount, c));
+    auto quadric = Utils::Quadric::FromTriangle(points[a], points[b], points[c], dimensions, 0.5 * glm::length(normal));
+    quadrics[a] += quadric;
+    quadrics[b] += quadric;
+    quadrics[c] += quadric;
+  }
+
+  struct Collapse {
+    uint32_t From;
+    uint32_t To;
+    double Error;
+  };
+
+  DynamicArray<uint32_t> result = indices;
+  DynamicArray<uint32_t> remap(vertexCount);
+  std::iota(remap.begin(), remap.end(), 0);
+  DynamicArray<uint32_t> adjacencyOffsets(vertexCount + 1);
+  DynamicArray<uint32_t> adjacency;
+  DynamicArray<bool> touched(vertexCount);
+  DynamicArray<uint32_t> neighbours;
+  double maxErrorSquared = static_cast<double>(targetError) * targetError;
+  double resultErrorSquared = 0.0;
+  targetIndexCount -= targetIndexCount % 3;
+
+  // Every pass collapses the cheapest edges whose neighbourhoods do not overlap, so the costs computed at the start of the pass stay exact
+  while (result.size() > targetIndexCount) {
+    std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+    for (auto index : result) adjacencyOffsets[index + 1]++;
+    for (uint32_t i = 0; i < vertexCount; i++) adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+    adjacency.resize(result.size());
+    {
+      DynamicArray<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+      for (uint32_t i = 0; i < result.size(); i++) adjacency[fill[result[i]]++] = i / 3;
+    }
+
+    DynamicArray<Collapse> collapses;
+    collapses.reserve(result.size());
+    for (size_t i = 0; i < result.size(); i += 3) {
+      for (uint32_t j = 0; j < 3; j++) {
+        auto from = result[i + j];
+        auto to = result[i + (j + 1) % 3];
+        if (!locked[from]) collapses.push_back({from, to, 0.0});
+        if (!locked[to]) collapses.push_back({to, from, 0.0});
+      }
+    }
+    for (auto& collapse : collapses) {
+      const auto& from = quadrics[collapse.From];
+      const auto& to = quadrics[collapse.To];
+      auto weight = from.Weight + to.Weight;
+      collapse.Error = weight > 0.0 ? (from.Evaluate(points[collapse.To], dimensions) + to.Evaluate(points[collapse.To], dimensions)) / weight : 0.0;
+    }
+    std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) {
+      return a.Error != b.Error ? a.Error < b.Error : (a.From != b.From ? a.From < b.From : a.To < b.To);
+    });
+
+    std::fill(touched.begin(), touched.end(), false);
+    size_t removedIndexCount = 0;
+    size_t collapseCount = 0;
+    for (const auto& collapse : collapses) {
+      if (result.size() - removedIndexCount <= targetIndexCount || collapse.Error > maxErrorSquared) break;
+      if (touched[collapse.From] || touched[collapse.To]) continue;
+
+      auto fromTriangles = adjacency.begin() + adjacencyOffsets[collapse.From];
+      auto fromTrianglesEnd = adjacency.begin() + adjacencyOffsets[collapse.From + 1];
+
+      // Link condition: the only vertices adjacent to both ends are the opposite corners of the triangles sharing the edge, otherwise the mesh folds
+      neighbours.clear();
+      uint32_t sharedTriangles = 0;
+      bool flipped = false;
+      for (auto triangle = fromTriangles; triangle != fromTrianglesEnd; ++triangle) {
+        const uint32_t* corners = &result[*triangle * 3];
+        bool shared = corners[0] == collapse.To || corners[1] == collapse.To || corners[2] == collapse.To;
+        sharedTriangles += shared;
+        for (uint32_t j = 0; j < 3; j++) {
+          if (corners[j] != collapse.From) neighbours.push_back(positionIDs[corners[j]]);
+        }
+        if (shared) continue;
+
+        glm::vec3 before[3];
+        glm::vec3 after[3];
+        for (uint32_t j = 0; j < 3; j++) {
+          before[j] = Utils::GetPosition(vertices, vertexFloatCount, corners[j]);
+          after[j] = Utils::GetPosition(vertices, vertexFloatCount, corners[j] == collapse.From ? collapse.To : corners[j]);
+        }
+        auto normalBefore = Utils::GetTriangleNormal(before[0], before[1], before[2]);
+        auto normalAfter = Utils::GetTriangleNormal(after[0], after[1], after[2]);
+        auto lengths = glm::length(normalBefore) * glm::length(normalAfter);
+        if (lengths <= 0.0f || glm::dot(normalBefore, normalAfter) < Utils::s_MinCollapseNormalDot * lengths) flipped = true;
+      }
+      if (flipped || sharedTriangles == 0) continue;
+
+      std::sort(neighbours.begin(), neighbours.end());
+      neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+      uint32_t commonNeighbours = 0;
+      for (auto triangle = adjacency.begin() + adjacencyOffsets[collapse.To]; triangle != adjacency.begin() + adjacencyOffsets[collapse.To + 1]; ++triangle) {
+        const uint32_t* corners = &result[*triangle * 3];
+        for (uint32_t j = 0; j < 3; j++) {
+          auto position = positionIDs[corners[j]];
+          auto it = std::lower_bound(neighbours.begin(), neighbours.end(), position);
+          if (position != positionIDs[collapse.To] && it != neighbours.end() && *it == position) {
+            // Count every common neighbour once
+            neighbours.erase(it);
+            commonNeighbours++;
+          }
+        }
+      }
+      if (commonNeighbours != sharedTriangles) continue;
+
+      // The whole one-ring is locked for the rest of the pass, its triangles are about to change
+      for (auto triangle = fromTriangles; triangle != fromTrianglesEnd; ++triangle) {
+        for (uint32_t j = 0; j < 3; j++) touched[result[*triangle * 3 + j]] = true;
+      }
+
+      remap[collapse.From] = collapse.To;
+      quadrics[collapse.To] += quadrics[collapse.From];
+      resultErrorSquared = std::max(resultErrorSquared, collapse.Error);
+      removedIndexCount += sharedTriangles * 3;
+      collapseCount++;
+    }
+
+    if (collapseCount == 0) break;
+
+    size_t writeIndex = 0;
+    for (size_t i = 0; i < result.size(); i += 3) {
+      auto a = remap[result[i]], b = remap[result[i + 1]], c = remap[result[i + 2]];
+      if (a == b || b == c || c == a) continue;
+      result[writeIndex++] = a;
+      result[writeIndex++] = b;
+      result[writeIndex++] = c;
+    }
+    result.resize(writeIndex);
+    for (uint32_t i = 0; i < vertexCount; i++) remap[i] = i;
+  }
+
+  if (resultError) *resultError = static_cast<float>(std::sqrt(std::max(resultErrorSquared, 0.0)));
+  return result;
+}
+
+DynamicArray<Meshlet> MeshOptimizer::BuildMeshlets(DynamicArray<uint32_t>& indices, const float* positions, uint32_t positionStride, uint32_t vertexCount,
+                                                   uint32_t maxVertices, uint32_t maxTriangles) {
+  ZoneScoped;
+
+  auto triangleCount = static_cast<uint32_t>(indices.size() / 3);
+  DynamicArray<Meshlet> meshlets;
+  if (triangleCount == 0) return meshlets;
+
+  DynamicArray<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+  for (auto index : indices) adjacencyOffsets[index + 1]++;
+  for (uint32_t i = 0; i < vertexCount; i++) adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+
+  DynamicArray<uint32_t> adjacency(indices.size());
+  {
+    DynamicArray<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (uint32_t i = 0; i < triangleCount * 3; i++) adjacency[fill[indices[i]]++] = i / 3;
+  }
+
+  DynamicArray<bool> emitted(triangleCount, false);
+  // Index of the meshlet a vertex was last added to, so membership tests do not need clearing between meshlets
+  DynamicArray<uint32_t> vertexMeshlet(vertexCount, Utils::s_InvalidIndex);
+  DynamicArray<uint32_t> meshletVertices;
+  DynamicArray<uint32_t> result;
+  result.reserve(indices.size());
+  uint32_t scanCursor = 0;
+
+  while (true) {
+    while (scanCursor < triangleCount && emitted[scanCursor]) scanCursor++;
+    if (scanCursor == triangleCount) break;
+
+    auto meshletIndex = static_cast<uint32_t>(meshlets.size());
+    Meshlet meshlet;
+    meshlet.FirstIndex = static_cast<uint32_t>(result.size());
+    meshletVertices.clear();
+    glm::vec3 centroidSum(0.0f);
+
+    auto addTriangle = [&](uint32_t triangle) {
+      emitted[triangle] = true;
+      for (uint32_t j = 0; j < 3; j++) {
+        auto vertex = indices[triangle * 3 + j];
+        result.push_back(vertex);
+        if (vertexMeshlet[vertex] == meshletIndex) continue;
+        vertexMeshlet[vertex] = meshletIndex;
+        meshletVertices.push_back(vertex);
+        centroidSum += Utils::GetPosition(positions, positionStride, vertex);
+      }
+      meshlet.IndexCount += 3;
+    };
+
+    addTriangle(scanCursor);
+    while (meshlet.IndexCount / 3 < maxTriangles) {
+      auto centroid = centroidSum / static_cast<float>(meshletVertices.size());
+      auto bestTriangle = Utils::s_InvalidIndex;
+      uint32_t bestNewVertices = 4;
+      float bestDistance = 0.0f;
+
+      for (auto vertex : meshletVertices) {
+        for (uint32_t i = adjacencyOffsets[vertex]; i < adjacencyOffsets[vertex + 1]; i++) {
+          auto triangle = adjacency[i];
+          if (emitted[triangle]) continue;
+
+          uint32_t newVertices = 0;
+          glm::vec3 triangleCentroid(0.0f);
+          for (uint32_t j = 0; j < 3; j++) {
+            auto corner = indices[triangle * 3 + j];
+            newVertices += vertexMeshlet[corner] != meshletIndex;
+            triangleCentroid += Utils::GetPosition(positions, positionStride, corner);
+          }
+          if (meshletVertices.size() + newVertices > maxVertices || newVertices > bestNewVertices) continue;
+
+          auto distance = glm::length(triangleCentroid / 3.0f - centroid);
+          if (newVertices < bestNewVertices || distance < bestDistance) {
+            bestTriangle = triangle;
+            bestNewVertices = newVertices;
+            bestDistance = distance;
+          }
+        }
+      }
+
+      // A meshlet without connected candidates ends early instead of jumping across the mesh
+      if (bestTriangle == Utils::s_InvalidIndex) break;
+      addTriangle(bestTriangle);
+    }
+
+    meshlet.VertexCount = static_cast<uint32_t>(meshletVertices.size());
+    Utils::ComputeMeshletBounds(meshlet, result, meshletVertices, positions, positionStride);
+    meshlets.push_back(meshlet);
+  }
+
+  indices = std::move(result);
+  return meshlets;
+}
@@ -2,10 +2,14 @@
 #include <Hydrogen/Core/Logger.hpp>
 #include <Hydrogen/Core/Window.hpp>
 #include <Hydrogen/Core/Task.hpp>
+#include <Hydrogen/Core/Cache.hpp>
+#include <Hydrogen/Core/JobSystem.hpp>
 #include <Hydrogen/Assets/AssetManager.hpp>
 #include <Hydrogen/Renderer/Context.hpp>
 #include <Hydrogen/Renderer/Renderer.hpp>
 #include <Hydrogen/Renderer/Framebuffer.hpp>
+#include <Hydrogen/Renderer/GeometryBuffer.hpp>
+#include <Hydrogen/Renderer/MeshStreaming.hpp>
 #include <Hydrogen/Scene/Scene.hpp>
 #include <imgui.h>
 
@@ -20,7 +24,9 @@ void Application::Run() {
   OnSetup();
   AppWindow = Window::Create(ApplicationInfo.Name, static_cast<uint32_t>(ApplicationInfo.WindowSize.x), static_cast<uint32_t>(ApplicationInfo.WindowSize.y));
 
+  JobSystem::Init();
   AssetManager::Init();
+  CacheFile::CollectGarbage();
 
   ProjectInformation clientProject;
   clientProject.ProjectName = ApplicationInfo.Name;
@@ -52,10 +58,12 @@ void Application::Run() {
     return result;
   });
 
+  Renderer::SetGeometryBuffer(GeometryBuffer::Create(MainRenderDevice));
+
   CurrentScene = NewScopePointer<Scene>("Main Scene");
 
   auto test = AssetManager::Get<MeshAsset>("assets/Meshes/viking_room.obj");
-  test->Spawn(MainRenderDevice, CurrentScene, "Room");
+  test->Spawn(CurrentScene, "Room");
 
   HY_ASSERT(!MainRenderDevice->ScreenSupported(AppWindow), "Screen is not supported!");  // TODO: Choose other graphics API or device
   auto renderer = NewReferencePointer<Renderer>(AppWindow, MainRenderDevice, CurrentScene);
@@ -86,6 +94,8 @@ void Application::Run() {
   OnInit();
 
   while (!AppWindow->GetWindowClose()) {
+    JobSystem::ProcessMainThreadJobs();
+    AssetManager::Update();
     TaskManager::Update();
     OnUpdate();
 
@@ -116,4 +126,10 @@ void Application::Run() {
   //Renderer::SetContext(nullptr);
 
   TaskManager::Shutdown();
+  JobSystem::Shutdown();
+
+  // The geometry buffer and the vertex arrays allocated from it have to be destroyed while the device is still alive, not with the statics
+  MeshStreaming::Shutdown();
+  CurrentScene.reset();
+  Renderer::SetGeometryBuffer(nullptr);
 }
@@ -1,43 +1,182 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <sstream>
+#include <thread>
 #include <Hydrogen/Core/Cache.hpp>
+#include <Hydrogen/Assets/AssetFileSystem.hpp>
 #include <Hydrogen/Core/Base.hpp>
 #include <Hydrogen/Core/Assert.hpp>
+#include <Hydrogen/Core/Hash.hpp>
+#include <tracy/Tracy.hpp>
+
+#if defined HY_PLATFORM_WINDOWS
+#include <process.h>
+#define HY_GET_PROCESS_ID() _getpid()
+#else
+#include <unistd.h>
+#define HY_GET_PROCESS_ID() getpid()
+#endif
+
+#ifndef HY_ENGINE_VERSION
+#define HY_ENGINE_VERSION "0.0.0"
+#endif
 
 using namespace Hydrogen;
 
-CacheFile::CacheFile(const String& path, const String& content) {
-  m_CacheFilepath = path + ".hycache";
+namespace Hydrogen::Utils {
+// Bump whenever the layout of cached artifacts changes
+static constexpr uint32_t s_CacheFormatVersion = 2;
 
-  m_ContentChecksum = std::hash<String>{}(content);
-  if (!std::filesystem::exists(m_CacheFilepath)) {
-    m_CacheCecksum.reset();
-    return;
-  }
+// Temporary files older than this are leftovers of crashed writers and may be collected
+static constexpr auto s_StaleTemporaryAge = std::chrono::minutes(10);
+static constexpr const char* s_TemporaryExtension = ".tmp";
 
-  std::ofstream cachefile;
-  cachefile.open(m_CacheFilepath, std::ios::in);
-  HY_ASSERT(cachefile.is_open(), "Failed to open file {}!", m_CacheFilepath);
-  std::stringstream cachefileStream;
-  cachefileStream << cachefile.rdbuf();
+static std::atomic<uint64_t> s_TemporaryCounter = 0;
+}  // namespace Hydrogen::Utils
+
+std::filesystem::path CacheFile::s_Directory = "cache";
+uintmax_t CacheFile::s_Budget = 256ULL * 1024 * 1024;
+
+CacheKey::CacheKey() : m_Value(Hash::s_FNVOffsetBasis) {
+  Add(HY_ENGINE_VERSION);
+  Add(Utils::s_CacheFormatVersion);
+}
+
+CacheKey& CacheKey::Add(const void* data, size_t size) {
+  // Hash the length too, so that ("ab", "c") and ("a", "bc") produce different keys
+  m_Value = Hash::FNV1a(&size, sizeof(size), m_Value);
+  m_Value = Hash::FNV1a(data, size, m_Value);
+  return *this;
+}
+
+CacheKey& CacheKey::Add(const String& value) { return Add(value.data(), value.size()); }
+
+CacheKey& CacheKey::Add(const char* value) { return Add(String(value)); }
+
+String CacheKey::ToString() const {
+  std::stringstream stream;
+  stream << std::hex;
+  stream.width(16);
+  stream.fill('0');
+  stream << m_Value;
+  return stream.str();
+}
+
+CacheFile::CacheFile(const std::filesystem::path& path, const CacheKey& key) {
+  // Artifacts are addressed by their key, so different compiler settings never overwrite each other
+  m_CacheFilepath = s_Directory / path;
+  m_CacheFilepath += "." + key.ToString();
+  m_PackFilepath = std::filesystem::path(s_PackDirectory) / path;
+  m_PackFilepath += "." + key.ToString();
+}
+
+std::optional<DynamicArray<char>> CacheFile::Read() {
+  ZoneScoped;
+
+  // Artifacts are immutable once published, a concurrent writer or collector can only replace or remove the whole file
+  auto startTime = std::chrono::steady_clock::now();
+  std::ifstream cachefile;
+  cachefile.open(m_CacheFilepath, std::ios::in | std::ios::binary | std::ios::ate);
+  if (!cachefile.is_open()) return AssetFileSystem::ReadFile(m_PackFilepath);
+
+  DynamicArray<char> data(static_cast<size_t>(cachefile.tellg()));
+  cachefile.seekg(0);
+  cachefile.read(data.data(), data.size());
+  if (!cachefile) return std::nullopt;
   cachefile.close();
-  size_t val;
-  cachefileStream >> val;
-  m_CacheCecksum = val;
+  AssetFileSystem::AddThreadReadStats(data.size(), std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count());
+
+  // The modification time doubles as access time for the LRU collection, atime is unreliable on noatime mounts
+  std::error_code error;
+  std::filesystem::last_write_time(m_CacheFilepath, std::filesystem::file_time_type::clock::now(), error);
+
+  return data;
 }
 
-bool CacheFile::CacheValid() { return m_CacheCecksum.has_value() && m_ContentChecksum == m_CacheCecksum.value(); }
+std::filesystem::path CacheFile::GetTemporaryFilepath(const std::filesystem::path& filepath) {
+  auto temporaryFilepath = filepath;
+  temporaryFilepath += "." + std::to_string(HY_GET_PROCESS_ID()) + "-" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + "-" +
+                       std::to_string(Utils::s_TemporaryCounter++) + Utils::s_TemporaryExtension;
+  return temporaryFilepath;
+}
 
-void CacheFile::UpdateCacheChecksum() {
-  String directory = DIRECTORY_FROM_PATH(m_CacheFilepath);
-  if (!std::filesystem::exists(directory)) {
-    std::filesystem::create_directories(directory);
-  }
+void CacheFile::Write(const void* data, size_t size) {
+  ZoneScoped;
+
+  auto directory = m_CacheFilepath.parent_path();
+  std::error_code error;
+  if (!directory.empty()) std::filesystem::create_directories(directory, error);
+
+  auto temporaryFilepath = GetTemporaryFilepath(m_CacheFilepath);
 
   std::ofstream cachefile;
-  cachefile.open(m_CacheFilepath, std::ios::out);
-  HY_ASSERT(cachefile.is_open(), "Failed to open file {}!", m_CacheFilepath);
-  cachefile << m_ContentChecksum;
+  cachefile.open(temporaryFilepath, std::ios::out | std::ios::binary | std::ios::trunc);
+  HY_ASSERT(cachefile.is_open(), "Failed to open file {}!", temporaryFilepath.string());
+  cachefile.write(static_cast<const char*>(data), size);
   cachefile.close();
+  HY_ASSERT(!cachefile.fail(), "Failed to write file {}!", temporaryFilepath.string());
+
+  std::filesystem::rename(temporaryFilepath, m_CacheFilepath, error);
+  if (error) {
+    // Another process published the same key first, its artifact has identical content
+    HY_LOG_DEBUG("Failed to publish cache file {}: {}", m_CacheFilepath.string(), error.message());
+    std::filesystem::remove(temporaryFilepath, error);
+  }
+}
+
+uintmax_t CacheFile::CollectGarbage() {
+  ZoneScoped;
+
+  struct Entry {
+    std::filesystem::path Filepath;
+    std::filesystem::file_time_type LastAccess;
+    uintmax_t Size;
+  };
+
+  std::error_code error;
+  if (!std::filesystem::exists(s_Directory, error)) return 0;
+
+  DynamicArray<Entry> entries;
+  uintmax_t totalSize = 0;
+  uintmax_t freedSize = 0;
+  auto now = std::filesystem::file_time_type::clock::now();
+  auto metadataDirectory = GetMetadataDirectory();
+
+  for (auto it = std::filesystem::recursive_directory_iterator(s_Directory, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+    std::error_code entryError;
+    if (!it->is_regular_file(entryError)) continue;
+
+    Entry entry{it->path(), it->last_write_time(entryError), it->file_size(entryError)};
+    if (entryError) continue;  // Removed by another process in the meantime
+
+    if (entry.Filepath.extension() == Utils::s_TemporaryExtension) {
+      if (now - entry.LastAccess > Utils::s_StaleTemporaryAge && std::filesystem::remove(entry.Filepath, entryError)) freedSize += entry.Size;
+      continue;
+    }
+
+    // Evicting the metadata would change the keys of the artifacts computed from it, so everything would be cooked again
+    if (entry.Filepath.parent_path() == metadataDirectory) continue;
+
+    totalSize += entry.Size;
+    entries.push_back(entry);
+  }
+
+  if (totalSize <= s_Budget) return freedSize;
+
+  std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.LastAccess < b.LastAccess; });
+
+  for (const auto& entry : entries) {
+    if (totalSize <= s_Budget) break;
+
+    // Losing the race against another collector is fine, the file is gone either way
+    std::filesystem::remove(entry.Filepath, error);
+    totalSize -= entry.Size;
+    if (!error) freedSize += entry.Size;
+  }
+
+  HY_LOG_INFO("Collected {} bytes from cache directory {}", freedSize, s_Directory.string());
+  return freedSize;
 }
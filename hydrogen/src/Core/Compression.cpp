@@ -0,0 +1,127 @@
+#include <Hydrogen/Core/Compression.hpp>
+#include <cstring>
+#include <tracy/Tracy.hpp>
+
+using namespace Hydrogen;
+
+namespace Hydrogen::Utils {
+static constexpr size_t s_MinMatch = 4;
+static constexpr size_t s_MaxOffset = 65535;
+static constexpr uint32_t s_HashBits = 16;
+// The last bytes are always emitted as literals, so the decoder never has to check a match against the end of the block
+static constexpr size_t s_LastLiterals = 5;
+
+static uint32_t HashSequence(const uint8_t* data) {
+  uint32_t sequence;
+  std::memcpy(&sequence, data, sizeof(sequence));
+  return (sequence * 2654435761U) >> (32 - s_HashBits);
+}
+
+static void WriteLength(DynamicArray<uint8_t>& output, size_t length) {
+  while (length >= 255) {
+    output.push_back(255);
+    length -= 255;
+  }
+  output.push_back(static_cast<uint8_t>(length));
+}
+
+// A sequence is a token (literal length << 4 | match length - 4), extra length bytes, the literals and a little endian 16 bit offset
+static void WriteSequence(DynamicArray<uint8_t>& output, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength) {
+  size_t matchCode = matchLength ? matchLength - s_MinMatch : 0;
+  output.push_back(static_cast<uint8_t>((std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(matchCode, 15)));
+  if (literalLength >= 15) WriteLength(output, literalLength - 15);
+  output.insert(output.end(), literals, literals + literalLength);
+
+  if (!matchLength) return;
+  output.push_back(static_cast<uint8_t>(offset & 0xff));
+  output.push_back(static_cast<uint8_t>(offset >> 8));
+  if (matchCode >= 15) WriteLength(output, matchCode - 15);
+}
+
+static bool ReadLength(const uint8_t*& input, const uint8_t* inputEnd, size_t& length) {
+  uint8_t byte;
+  do {
+    if (input >= inputEnd) return false;
+    byte = *input++;
+    length += byte;
+  } while (byte == 255);
+  return true;
+}
+}  // namespace Hydrogen::Utils
+
+DynamicArray<uint8_t> Compression::Compress(const void* data, size_t size) {
+  ZoneScoped;
+
+  auto input = static_cast<const uint8_t*>(data);
+  DynamicArray<uint8_t> output;
+  output.reserve(size + size / 255 + 16);
+
+  DynamicArray<uint32_t> table(1 << Utils::s_HashBits, UINT32_MAX);
+  size_t anchor = 0;
+  size_t position = 0;
+
+  if (size > Utils::s_LastLiterals + Utils::s_MinMatch) {
+    size_t matchLimit = size - Utils::s_LastLiterals;
+    while (position + Utils::s_MinMatch <= matchLimit) {
+      auto hash = Utils::HashSequence(input + position);
+      size_t candidate = table[hash];
+      table[hash] = static_cast<uint32_t>(position);
+
+      if (candidate == UINT32_MAX || position - candidate > Utils::s_MaxOffset || std::memcmp(input + candidate, input + position, Utils::s_MinMatch) != 0) {
+        position++;
+        continue;
+      }
+
+      size_t matchLength = Utils::s_MinMatch;
+      while (position + matchLength < matchLimit && input[candidate + matchLength] == input[position + matchLength]) matchLength++;
+
+      Utils::WriteSequence(output, input + anchor, position - anchor, position - candidate, matchLength);
+      position += matchLength;
+      anchor = position;
+    }
+  }
+
+  Utils::WriteSequence(output, input + anchor, size - anchor, 0, 0);
+  return output;
+}
+
+bool Compression::Decompress(const void* data, size_t size, void* decompressed, size_t decompressedSize) {
+  ZoneScoped;
+
+  auto input = static_cast<const uint8_t*>(data);
+  auto inputEnd = input + size;
+  auto output = static_cast<uint8_t*>(decompressed);
+  auto outputStart = output;
+  auto outputEnd = output + decompressedSize;
+
+  while (input < inputEnd) {
+    uint8_t token = *input++;
+
+    size_t literalLength = token >> 4;
+    if (literalLength == 15 && !Utils::ReadLength(input, inputEnd, literalLength)) return false;
+    if (literalLength > static_cast<size_t>(inputEnd - input) || literalLength > static_cast<size_t>(outputEnd - output)) return false;
+    if (literalLength) std::memcpy(output, input, literalLength);
+    input += literalLength;
+    output += literalLength;
+
+    // The final sequence carries literals only
+    if (input == inputEnd) break;
+
+    if (inputEnd - input < 2) return false;
+    size_t offset = input[0] | (static_cast<size_t>(input[1]) << 8);
+    input += 2;
+    if (offset == 0 || offset > static_cast<size_t>(output - outputStart)) return false;
+
+    size_t matchLength = token & 0x0f;
+    if (matchLength == 15 && !Utils::ReadLength(input, inputEnd, matchLength)) return false;
+    matchLength += Utils::s_MinMatch;
+    if (matchLength > static_cast<size_t>(outputEnd - output)) return false;
+
+    // Byte by byte on purpose, overlapping matches (offset < length) repeat the pattern
+    const uint8_t* match = output - offset;
+    for (size_t i = 0; i < matchLength; i++) output[i] = match[i];
+    output += matchLength;
+  }
+
+  return output == outputEnd;
+}
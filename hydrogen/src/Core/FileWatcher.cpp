@@ -0,0 +1,138 @@
+#include <Hydrogen/Core/FileWatcher.hpp>
+#include <Hydrogen/Core/Logger.hpp>
+#include <algorithm>
+#include <tracy/Tracy.hpp>
+
+#if defined HY_PLATFORM_LINUX
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+using namespace Hydrogen;
+
+namespace Hydrogen::Utils {
+#if !defined HY_PLATFORM_LINUX
+// Scanning the whole tree is expensive, so the polling fallback runs at most this often
+static constexpr auto s_PollInterval = std::chrono::milliseconds(250);
+#endif
+
+static void SortUnique(DynamicArray<std::filesystem::path>& paths) {
+  std::sort(paths.begin(), paths.end());
+  paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+}
+}  // namespace Hydrogen::Utils
+
+#if defined HY_PLATFORM_LINUX
+FileWatcher::FileWatcher(const std::filesystem::path& directory) : m_Directory(directory) {
+  ZoneScoped;
+
+  m_Descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (m_Descriptor < 0) {
+    HY_LOG_WARN("Failed to initialize inotify, hot reload of {} is disabled", directory.string());
+    return;
+  }
+
+  AddWatches(directory);
+}
+
+FileWatcher::~FileWatcher() {
+  if (m_Descriptor >= 0) close(m_Descriptor);
+}
+
+void FileWatcher::AddWatches(const std::filesystem::path& directory) {
+  // inotify is not recursive, every subdirectory needs its own watch
+  constexpr uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE;
+
+  auto addWatch = [this](const std::filesystem::path& path) {
+    int watch = inotify_add_watch(m_Descriptor, path.c_str(), mask);
+    if (watch < 0) {
+      HY_LOG_WARN("Failed to watch directory {}", path.string());
+      return;
+    }
+    m_Watches[watch] = path;
+  };
+
+  addWatch(directory);
+  std::error_code error;
+  for (auto it = std::filesystem::recursive_directory_iterator(directory, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+    if (it->is_directory(error) && !it->is_symlink(error)) addWatch(it->path());
+  }
+}
+
+DynamicArray<std::filesystem::path> FileWatcher::Poll() {
+  ZoneScoped;
+
+  DynamicArray<std::filesystem::path> changes;
+  if (m_Descriptor < 0) return changes;
+
+  alignas(inotify_event) char buffer[4096];
+  while (true) {
+    auto length = read(m_Descriptor, buffer, sizeof(buffer));
+    if (length <= 0) break;  // EAGAIN, nothing left to read
+
+    for (ssize_t offset = 0; offset < length;) {
+      auto event = reinterpret_cast<const inotify_event*>(buffer + offset);
+      offset += sizeof(inotify_event) + event->len;
+
+      auto it = m_Watches.find(event->wd);
+      if (it == m_Watches.end() || event->len == 0) continue;
+      auto path = it->second / event->name;
+
+      if (event->mask & IN_ISDIR) {
+        if (event->mask & (IN_CREATE | IN_MOVED_TO)) AddWatches(path);
+        continue;
+      }
+
+      // IN_CREATE is followed by IN_CLOSE_WRITE once the content is there, reporting it now would reload a half written file
+      if (event->mask & IN_CREATE) continue;
+      changes.push_back(path.lexically_normal());
+    }
+  }
+
+  Utils::SortUnique(changes);
+  return changes;
+}
+#else
+FileWatcher::FileWatcher(const std::filesystem::path& directory) : m_Directory(directory) {
+  ZoneScoped;
+
+  std::error_code error;
+  for (auto it = std::filesystem::recursive_directory_iterator(directory, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+    if (it->is_regular_file(error)) m_Timestamps[it->path().lexically_normal().generic_string()] = it->last_write_time(error);
+  }
+  m_LastScan = std::chrono::steady_clock::now();
+}
+
+FileWatcher::~FileWatcher() = default;
+
+DynamicArray<std::filesystem::path> FileWatcher::Poll() {
+  ZoneScoped;
+
+  DynamicArray<std::filesystem::path> changes;
+  auto now = std::chrono::steady_clock::now();
+  if (now - m_LastScan < Utils::s_PollInterval) return changes;
+  m_LastScan = now;
+
+  UnorderedMap<String, std::filesystem::file_time_type> timestamps;
+  std::error_code error;
+  for (auto it = std::filesystem::recursive_directory_iterator(m_Directory, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+    if (!it->is_regular_file(error)) continue;
+
+    auto path = it->path().lexically_normal().generic_string();
+    auto timestamp = it->last_write_time(error);
+    timestamps[path] = timestamp;
+
+    auto previous = m_Timestamps.find(path);
+    if (previous == m_Timestamps.end() || previous->second != timestamp) changes.push_back(path);
+  }
+
+  for (const auto& [path, timestamp] : m_Timestamps) {
+    if (!timestamps.count(path)) changes.push_back(path);
+  }
+
+  m_Timestamps = std::move(timestamps);
+  Utils::SortUnique(changes);
+  return changes;
+}
+#endif
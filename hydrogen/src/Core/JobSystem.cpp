@@ -0,0 +1,159 @@
+#include <Hydrogen/Core/JobSystem.hpp>
+#include <Hydrogen/Core/Logger.hpp>
+#include <algorithm>
+#include <tracy/Tracy.hpp>
+
+using namespace Hydrogen;
+
+DynamicArray<std::thread> JobSystem::s_Workers;
+std::deque<std::function<void()>> JobSystem::s_Jobs;
+std::mutex JobSystem::s_JobsMutex;
+std::condition_variable JobSystem::s_JobsAvailable;
+std::condition_variable JobSystem::s_JobsFinished;
+uint64_t JobSystem::s_PendingJobs = 0;
+bool JobSystem::s_Running = false;
+
+DynamicArray<std::function<void()>> JobSystem::s_MainThreadJobs;
+std::mutex JobSystem::s_MainThreadJobsMutex;
+
+void JobSystem::Init(uint32_t threadCount) {
+  ZoneScoped;
+  if (s_Running) return;
+
+  if (threadCount == 0) {
+    threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+  }
+
+  s_Running = true;
+  s_Workers.reserve(threadCount);
+  for (uint32_t i = 0; i < threadCount; i++) {
+    s_Workers.emplace_back(&JobSystem::WorkerLoop);
+  }
+
+  HY_LOG_INFO("Initialized job system with {} worker threads", threadCount);
+}
+
+void JobSystem::Shutdown() {
+  ZoneScoped;
+  if (!s_Running) return;
+
+  WaitForIdle();
+
+  {
+    std::lock_guard<std::mutex> lock(s_JobsMutex);
+    s_Running = false;
+  }
+  s_JobsAvailable.notify_all();
+
+  for (auto& worker : s_Workers) {
+    worker.join();
+  }
+  s_Workers.clear();
+
+  ProcessMainThreadJobs();
+}
+
+void JobSystem::Execute(const std::function<void()>& job) {
+  {
+    std::unique_lock<std::mutex> lock(s_JobsMutex);
+    if (!s_Running) {
+      lock.unlock();
+      job();
+      return;
+    }
+
+    s_Jobs.push_back(job);
+    s_PendingJobs++;
+  }
+  s_JobsAvailable.notify_one();
+}
+
+void JobSystem::Dispatch(uint32_t count, const std::function<void(uint32_t)>& job) {
+  ZoneScoped;
+  if (count == 0) return;
+
+  // Indices are claimed through a shared counter, so uneven job costs balance out between threads
+  auto nextIndex = NewReferencePointer<std::atomic<uint32_t>>(0);
+  auto remaining = NewReferencePointer<std::atomic<uint32_t>>(count);
+  auto done = NewReferencePointer<std::promise<void>>();
+  std::shared_future<void> future = done->get_future().share();
+
+  auto worker = [nextIndex, remaining, done, count, &job]() {
+    uint32_t index;
+    while ((index = nextIndex->fetch_add(1)) < count) {
+      job(index);
+      if (remaining->fetch_sub(1) == 1) done->set_value();
+    }
+  };
+
+  uint32_t helpers = std::min(GetThreadCount(), count - 1);
+  for (uint32_t i = 0; i < helpers; i++) {
+    Execute(worker);
+  }
+
+  worker();
+  Wait(future);
+}
+
+void JobSystem::WaitForIdle() {
+  ZoneScoped;
+  while (RunPendingJob()) {
+  }
+
+  std::unique_lock<std::mutex> lock(s_JobsMutex);
+  s_JobsFinished.wait(lock, []() { return s_PendingJobs == 0; });
+}
+
+bool JobSystem::RunPendingJob() {
+  std::function<void()> job;
+  {
+    std::lock_guard<std::mutex> lock(s_JobsMutex);
+    if (s_Jobs.empty()) return false;
+    job = std::move(s_Jobs.front());
+    s_Jobs.pop_front();
+  }
+
+  job();
+
+  {
+    std::lock_guard<std::mutex> lock(s_JobsMutex);
+    s_PendingJobs--;
+  }
+  s_JobsFinished.notify_all();
+  return true;
+}
+
+void JobSystem::ExecuteOnMainThread(const std::function<void()>& job) {
+  std::lock_guard<std::mutex> lock(s_MainThreadJobsMutex);
+  s_MainThreadJobs.push_back(job);
+}
+
+void JobSystem::ProcessMainThreadJobs() {
+  ZoneScoped;
+
+  DynamicArray<std::function<void()>> jobs;
+  {
+    std::lock_guard<std::mutex> lock(s_MainThreadJobsMutex);
+    jobs.swap(s_MainThreadJobs);
+  }
+
+  for (auto& job : jobs) {
+    job();
+  }
+}
+
+uint32_t JobSystem::GetThreadCount() { return static_cast<uint32_t>(s_Workers.size()); }
+
+bool JobSystem::IsInitialized() { return s_Running; }
+
+void JobSystem::WorkerLoop() {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(s_JobsMutex);
+      s_JobsAvailable.wait(lock, []() { return !s_Running || !s_Jobs.empty(); });
+      if (!s_Running && s_Jobs.empty()) return;
+    }
+
+    RunPendingJob();
+  }
+}
@@ -0,0 +1,86 @@
+#include <Hydrogen/Core/MappedFile.hpp>
+#include <Hydrogen/Core/Logger.hpp>
+#include <tracy/Tracy.hpp>
+
+#if defined HY_PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Hydrogen;
+
+MappedFile::MappedFile(const std::filesystem::path& filepath) : m_Filepath(filepath) {
+  ZoneScoped;
+
+#if defined HY_PLATFORM_WINDOWS
+  HANDLE file = CreateFileW(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    HY_LOG_WARN("Failed to open file {} for mapping", filepath.string());
+    return;
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+    CloseHandle(file);
+    return;
+  }
+
+  HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping) {
+    HY_LOG_WARN("Failed to map file {}", filepath.string());
+    CloseHandle(file);
+    return;
+  }
+
+  m_Data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  if (!m_Data) {
+    HY_LOG_WARN("Failed to map file {}", filepath.string());
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return;
+  }
+
+  m_Size = static_cast<size_t>(size.QuadPart);
+  m_FileHandle = file;
+  m_MappingHandle = mapping;
+#else
+  int file = open(filepath.c_str(), O_RDONLY);
+  if (file < 0) {
+    HY_LOG_WARN("Failed to open file {} for mapping", filepath.string());
+    return;
+  }
+
+  struct stat status;
+  if (fstat(file, &status) != 0 || status.st_size == 0) {
+    close(file);
+    return;
+  }
+
+  void* data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+  // The mapping stays valid after the descriptor is closed
+  close(file);
+  if (data == MAP_FAILED) {
+    HY_LOG_WARN("Failed to map file {}", filepath.string());
+    return;
+  }
+
+  m_Data = static_cast<const uint8_t*>(data);
+  m_Size = static_cast<size_t>(status.st_size);
+#endif
+}
+
+MappedFile::~MappedFile() {
+  if (!m_Data) return;
+
+#if defined HY_PLATFORM_WINDOWS
+  UnmapViewOfFile(m_Data);
+  CloseHandle(m_MappingHandle);
+  CloseHandle(m_FileHandle);
+#else
+  munmap(const_cast<uint8_t*>(m_Data), m_Size);
+#endif
+}
@@ -0,0 +1,82 @@
+#include <Hydrogen/Core/UUID.hpp>
+#include <Hydrogen/Core/Assert.hpp>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <tracy/Tracy.hpp>
+
+using namespace Hydrogen;
+
+namespace Hydrogen::Utils {
+static std::atomic<uint64_t> s_SeedEpoch = 1;
+static std::atomic<bool> s_Deterministic = false;
+static std::atomic<uint64_t> s_Seed = 0;
+// Published by the epoch increment, which thread runs which job is up to the scheduler, so only the seeding thread has a reproducible sequence
+static std::thread::id s_SeedThread;
+
+static uint64_t SplitMix64(uint64_t& state) {
+  uint64_t z = (state += 0x9e37'79b9'7f4a'7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58'476d'1ce4'e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d0'49bb'1331'11ebULL;
+  return z ^ (z >> 31);
+}
+
+// Seeded once per thread, so generating an id is a few arithmetic instructions instead of a random_device read
+struct UUIDGenerator {
+  uint64_t State = 0;
+  uint64_t Epoch = 0;
+
+  uint64_t Next() {
+    auto epoch = s_SeedEpoch.load(std::memory_order_acquire);
+    if (Epoch != epoch) {
+      Epoch = epoch;
+      if (s_Deterministic.load(std::memory_order_relaxed)) {
+        HY_ASSERT_CHECK(std::this_thread::get_id() == s_SeedThread, "Seeded UUIDs can only be generated on the thread that called UUID::SetSeed!");
+        State = s_Seed.load(std::memory_order_relaxed);
+      } else {
+        std::random_device rd;
+        State = (static_cast<uint64_t>(rd()) << 32) ^ rd();
+      }
+    }
+
+    uint64_t value = SplitMix64(State);
+
+    // Set version (4) and variant (10xxxxxx)
+    value &= ~(0xf000'0000'0000'0000ULL);  // Clear version bits
+    value |= 0x4000'0000'0000'0000ULL;     // Set version 4
+    value &= ~(0xc000'0000'0000'0000ULL);  // Clear variant bits
+    value |= 0x8000'0000'0000'0000ULL;     // Set variant 10
+
+    return value;
+  }
+};
+
+static thread_local UUIDGenerator s_Generator;
+}  // namespace Hydrogen::Utils
+
+UUID::UUID() { m_Value = Utils::s_Generator.Next(); }
+
+DynamicArray<UUID> UUID::Batch(size_t count) {
+  ZoneScoped;
+  auto& generator = Utils::s_Generator;
+
+  DynamicArray<UUID> uuids;
+  uuids.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    uuids.emplace_back(generator.Next());
+  }
+
+  return uuids;
+}
+
+void UUID::SetSeed(uint64_t seed) {
+  Utils::s_Seed.store(seed, std::memory_order_relaxed);
+  Utils::s_SeedThread = std::this_thread::get_id();
+  Utils::s_Deterministic.store(true, std::memory_order_relaxed);
+  Utils::s_SeedEpoch.fetch_add(1, std::memory_order_release);
+}
+
+void UUID::ResetSeed() {
+  Utils::s_Deterministic.store(false, std::memory_order_relaxed);
+  Utils::s_SeedEpoch.fetch_add(1, std::memory_order_release);
+}
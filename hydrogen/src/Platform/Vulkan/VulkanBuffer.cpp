@@ -53,22 +53,26 @@ VulkanBuffer::~VulkanBuffer() {
   vkFreeMemory(m_RenderDevice->GetDevice(), m_BufferMemory, nullptr);
 }
 
-VulkanVertexBuffer::VulkanVertexBuffer(const ReferencePointer<RenderDevice>& device, float* vertices, size_t size)
-    : m_Size(size),
-      VulkanBuffer(std::dynamic_pointer_cast<VulkanRenderDevice>(device), size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) {
+void VulkanBuffer::Upload(const void* source, VkDeviceSize size, VkDeviceSize offset) {
   ZoneScoped;
 
   auto vulkanDevice = m_RenderDevice->GetDevice();
 
-  VulkanBuffer stagingBuffer(std::dynamic_pointer_cast<VulkanRenderDevice>(device), size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+  VulkanBuffer stagingBuffer(m_RenderDevice, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 
   void* data;
   vkMapMemory(vulkanDevice, stagingBuffer.GetBufferMemory(), 0, size, 0, &data);
-  memcpy(data, vertices, size);
+  memcpy(data, source, size);
   vkUnmapMemory(vulkanDevice, stagingBuffer.GetBufferMemory());
 
+  stagingBuffer.CopyTo({{m_Buffer, {0, offset, size}}});
+}
+
+void VulkanBuffer::CopyTo(const DynamicArray<VulkanBufferCopy>& copies) {
+  ZoneScoped;
+
+  auto vulkanDevice = m_RenderDevice->GetDevice();
+
   VkCommandBufferAllocateInfo allocInfo{};
   allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
   allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
@@ -83,11 +87,7 @@ VulkanVertexBuffer::VulkanVertexBuffer(const ReferencePointer<RenderDevice>& dev
   beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
   vkBeginCommandBuffer(commandBuffer, &beginInfo);
-  VkBufferCopy copyRegion{};
-  copyRegion.srcOffset = 0;
-  copyRegion.dstOffset = 0;
-  copyRegion.size = size;
-  vkCmdCopyBuffer(commandBuffer, stagingBuffer.GetBuffer(), m_Buffer, 1, &copyRegion);
+  for (const auto& copy : copies) vkCmdCopyBuffer(commandBuffer, m_Buffer, copy.Destination, 1, &copy.Region);
   vkEndCommandBuffer(commandBuffer);
 
   VkSubmitInfo submitInfo{};
@@ -101,69 +101,38 @@ VulkanVertexBuffer::VulkanVertexBuffer(const ReferencePointer<RenderDevice>& dev
   vkFreeCommandBuffers(vulkanDevice, m_RenderDevice->GetCommandPool(), 1, &commandBuffer);
 }
 
+VulkanVertexBuffer::VulkanVertexBuffer(const ReferencePointer<RenderDevice>& device, const void* vertices, size_t size)
+    : m_Size(size),
+      VulkanBuffer(std::dynamic_pointer_cast<VulkanRenderDevice>(device), size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) {
+  ZoneScoped;
+
+  Upload(vertices, size);
+}
+
 VulkanVertexBuffer::~VulkanVertexBuffer() {
 }
 
 void VulkanVertexBuffer::Bind(const ReferencePointer<CommandBuffer>& commandBuffer) const {
   ZoneScoped;
-  VkBuffer vertexBuffers[] = {m_Buffer};
-  VkDeviceSize offsets[] = {0};
-  vkCmdBindVertexBuffers(std::dynamic_pointer_cast<VulkanCommandBuffer>(commandBuffer)->GetCommandBuffer(), 0, 1, vertexBuffers, offsets);
+  std::dynamic_pointer_cast<VulkanCommandBuffer>(commandBuffer)->BindVertexBuffer(m_Buffer);
 }
 
-VulkanIndexBuffer::VulkanIndexBuffer(const ReferencePointer<RenderDevice>& device, uint32_t* indices, size_t size)
-    : m_Count(size / sizeof(uint32_t)),
+VulkanIndexBuffer::VulkanIndexBuffer(const ReferencePointer<RenderDevice>& device, const void* indices, size_t size, IndexType type)
+    : m_Count(size / Hydrogen::Utils::IndexTypeSize(type)),
+      m_Type(type),
       VulkanBuffer(std::dynamic_pointer_cast<VulkanRenderDevice>(device), size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) {
   ZoneScoped;
 
-  auto vulkanDevice = m_RenderDevice->GetDevice();
-
-  VulkanBuffer stagingBuffer(std::dynamic_pointer_cast<VulkanRenderDevice>(device), size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-  void* data;
-  vkMapMemory(vulkanDevice, stagingBuffer.GetBufferMemory(), 0, size, 0, &data);
-  memcpy(data, indices, size);
-  vkUnmapMemory(vulkanDevice, stagingBuffer.GetBufferMemory());
-
-  VkCommandBufferAllocateInfo allocInfo{};
-  allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-  allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-  allocInfo.commandPool = m_RenderDevice->GetCommandPool();
-  allocInfo.commandBufferCount = 1;
-
-  VkCommandBuffer commandBuffer;
-  vkAllocateCommandBuffers(vulkanDevice, &allocInfo, &commandBuffer);
-
-  VkCommandBufferBeginInfo beginInfo{};
-  beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-  beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-  vkBeginCommandBuffer(commandBuffer, &beginInfo);
-  VkBufferCopy copyRegion{};
-  copyRegion.srcOffset = 0;
-  copyRegion.dstOffset = 0;
-  copyRegion.size = size;
-  vkCmdCopyBuffer(commandBuffer, stagingBuffer.GetBuffer(), m_Buffer, 1, &copyRegion);
-  vkEndCommandBuffer(commandBuffer);
-
-  VkSubmitInfo submitInfo{};
-  submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-  submitInfo.commandBufferCount = 1;
-  submitInfo.pCommandBuffers = &commandBuffer;
-
-  vkQueueSubmit(m_RenderDevice->GetGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE);
-  vkQueueWaitIdle(m_RenderDevice->GetGraphicsQueue());
-
-  vkFreeCommandBuffers(vulkanDevice, m_RenderDevice->GetCommandPool(), 1, &commandBuffer);
+  Upload(indices, size);
 }
 
 VulkanIndexBuffer::~VulkanIndexBuffer() { ZoneScoped; }
 
 void VulkanIndexBuffer::Bind(const ReferencePointer<CommandBuffer>& commandBuffer) const {
   ZoneScoped;
-  vkCmdBindIndexBuffer(std::dynamic_pointer_cast<VulkanCommandBuffer>(commandBuffer)->GetCommandBuffer(), m_Buffer, 0, VK_INDEX_TYPE_UINT32);
+  std::dynamic_pointer_cast<VulkanCommandBuffer>(commandBuffer)->BindIndexBuffer(m_Buffer, m_Type == IndexType::UInt16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32);
 }
 
 VulkanUniformBuffer::VulkanUniformBuffer(const ReferencePointer<RenderDevice>& device, size_t size)
@@ -63,6 +63,9 @@ void VulkanCommandBuffer::Begin() {
   beginInfo.pInheritanceInfo = nullptr;  // Optional
 
   VK_CHECK_ERROR(vkBeginCommandBuffer(m_CommandBuffer, &beginInfo), "Failed to begin vulkan command buffer!");
+
+  m_BoundVertexBuffer = VK_NULL_HANDLE;
+  m_BoundIndexBuffer = VK_NULL_HANDLE;
 }
 
 void VulkanCommandBuffer::End() {
@@ -119,7 +122,29 @@ void VulkanCommandBuffer::CmdDraw(const ReferencePointer<VertexBuffer>& vertexBu
 
 void VulkanCommandBuffer::CmdDrawIndexed(const ReferencePointer<class VertexArray>& vertexArray) {
   ZoneScoped;
-  vkCmdDrawIndexed(m_CommandBuffer, static_cast<uint32_t>(vertexArray->GetIndexBuffer()->GetCount()), 1, 0, 0, 0);
+  vkCmdDrawIndexed(m_CommandBuffer, static_cast<uint32_t>(vertexArray->GetIndexBuffer()->GetCount()), 1, vertexArray->GetFirstIndex(), vertexArray->GetVertexOffset(), 0);
+}
+
+void VulkanCommandBuffer::CmdDrawIndexed(const ReferencePointer<class VertexArray>& vertexArray, uint32_t indexCount, uint32_t firstIndex) {
+  ZoneScoped;
+  HY_ASSERT(static_cast<size_t>(firstIndex) + indexCount <= vertexArray->GetIndexBuffer()->GetCount(), "Index range exceeds the index buffer!");
+  vkCmdDrawIndexed(m_CommandBuffer, indexCount, 1, vertexArray->GetFirstIndex() + firstIndex, vertexArray->GetVertexOffset(), 0);
+}
+
+void VulkanCommandBuffer::BindVertexBuffer(VkBuffer buffer) {
+  if (buffer == m_BoundVertexBuffer) return;
+
+  VkDeviceSize offset = 0;
+  vkCmdBindVertexBuffers(m_CommandBuffer, 0, 1, &buffer, &offset);
+  m_BoundVertexBuffer = buffer;
+}
+
+void VulkanCommandBuffer::BindIndexBuffer(VkBuffer buffer, VkIndexType type) {
+  if (buffer == m_BoundIndexBuffer && type == m_BoundIndexType) return;
+
+  vkCmdBindIndexBuffer(m_CommandBuffer, buffer, 0, type);
+  m_BoundIndexBuffer = buffer;
+  m_BoundIndexType = type;
 }
 
 void VulkanCommandBuffer::CmdSetViewport(const ReferencePointer<SwapChain>& swapChain, uint32_t width, uint32_t height) {
@@ -159,4 +184,8 @@ void VulkanCommandBuffer::CmdDrawImGuiDrawData(const ReferencePointer<Shader>& s
   if (shader != nullptr) pipeline = std::dynamic_pointer_cast<VulkanShader>(shader)->GetPipeline();
 
   ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), m_CommandBuffer, pipeline);
+
+  // ImGui binds its own vertex and index buffers
+  m_BoundVertexBuffer = VK_NULL_HANDLE;
+  m_BoundIndexBuffer = VK_NULL_HANDLE;
 }
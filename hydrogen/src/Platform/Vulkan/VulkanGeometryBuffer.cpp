@@ -0,0 +1,155 @@
+#include <Hydrogen/Platform/Vulkan/VulkanGeometryBuffer.hpp>
+#include <Hydrogen/Platform/Vulkan/VulkanRenderDevice.hpp>
+#include <Hydrogen/Platform/Vulkan/VulkanCommandBuffer.hpp>
+#include <Hydrogen/Core/Base.hpp>
+#include <Hydrogen/Core/Logger.hpp>
+#include <algorithm>
+#include <tracy/Tracy.hpp>
+
+using namespace Hydrogen;
+using namespace Hydrogen::Vulkan;
+
+VulkanGeometryBuffer::VulkanGeometryBuffer(const ReferencePointer<RenderDevice>& device, size_t vertexPageSize, size_t indexPageSize)
+    : m_RenderDevice(std::dynamic_pointer_cast<VulkanRenderDevice>(device)), m_VertexPageSize(vertexPageSize), m_IndexPageSize(indexPageSize) {}
+
+ReferencePointer<VertexBuffer> VulkanGeometryBuffer::AllocateVertices(const void* vertices, size_t size, uint32_t stride) {
+  ZoneScoped;
+  HY_ASSERT(stride != 0 && size % stride == 0, "Vertex data must be a whole number of vertices!");
+
+  auto allocation = Allocate(m_VertexPages, vertices, size, stride, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, m_VertexPageSize);
+  return NewReferencePointer<VulkanGeometryVertexBuffer>(shared_from_this(), allocation);
+}
+
+ReferencePointer<IndexBuffer> VulkanGeometryBuffer::AllocateIndices(const void* indices, size_t size, IndexType type) {
+  ZoneScoped;
+  auto indexSize = Hydrogen::Utils::IndexTypeSize(type);
+  HY_ASSERT(size % indexSize == 0, "Index data must be a whole number of indices!");
+
+  auto allocation = Allocate(m_IndexPages, indices, size, indexSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, m_IndexPageSize);
+  return NewReferencePointer<VulkanGeometryIndexBuffer>(shared_from_this(), allocation, type);
+}
+
+void VulkanGeometryBuffer::BeginUploads() {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_UploadBatchDepth++;
+}
+
+void VulkanGeometryBuffer::SubmitUploads() {
+  ZoneScoped;
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  HY_ASSERT(m_UploadBatchDepth > 0, "SubmitUploads called without BeginUploads!");
+
+  if (--m_UploadBatchDepth > 0 || m_PendingUploads.empty()) return;
+
+  auto vulkanDevice = m_RenderDevice->GetDevice();
+  VulkanBuffer stagingBuffer(m_RenderDevice, m_UploadData.size(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+  void* data;
+  vkMapMemory(vulkanDevice, stagingBuffer.GetBufferMemory(), 0, m_UploadData.size(), 0, &data);
+  memcpy(data, m_UploadData.data(), m_UploadData.size());
+  vkUnmapMemory(vulkanDevice, stagingBuffer.GetBufferMemory());
+
+  DynamicArray<VulkanBufferCopy> copies;
+  copies.reserve(m_PendingUploads.size());
+  for (const auto& upload : m_PendingUploads) copies.push_back({upload.Destination, {upload.SourceOffset, upload.DestinationOffset, upload.Size}});
+  stagingBuffer.CopyTo(copies);
+
+  HY_LOG_DEBUG("Uploaded {} geometry ranges with {} bytes in one batch", m_PendingUploads.size(), m_UploadData.size());
+  m_UploadData = DynamicArray<uint8_t>();
+  m_PendingUploads.clear();
+}
+
+void VulkanGeometryBuffer::NextFrame() {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  for (auto& pendingFree : m_PendingFrees) {
+    if (--pendingFree.FramesLeft == 0) (*pendingFree.Pages)[pendingFree.Range.Page].Allocator.Free(pendingFree.Range.Offset, pendingFree.Range.Size);
+  }
+  std::erase_if(m_PendingFrees, [](const PendingFree& pendingFree) { return pendingFree.FramesLeft == 0; });
+}
+
+GeometryBufferStats VulkanGeometryBuffer::GetStats() {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  GeometryBufferStats stats;
+  for (const auto& page : m_VertexPages) {
+    stats.VertexCapacity += page.Allocator.GetSize();
+    stats.VertexUsage += page.Allocator.GetUsedSize();
+  }
+  for (const auto& page : m_IndexPages) {
+    stats.IndexCapacity += page.Allocator.GetSize();
+    stats.IndexUsage += page.Allocator.GetUsedSize();
+  }
+  stats.PageCount = static_cast<uint32_t>(m_VertexPages.size() + m_IndexPages.size());
+  return stats;
+}
+
+VkBuffer VulkanGeometryBuffer::GetVertexPage(uint32_t page) {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_VertexPages[page].Buffer->GetBuffer();
+}
+
+VkBuffer VulkanGeometryBuffer::GetIndexPage(uint32_t page) {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_IndexPages[page].Buffer->GetBuffer();
+}
+
+void VulkanGeometryBuffer::FreeVertices(const Allocation& allocation) { Free(m_VertexPages, allocation); }
+
+void VulkanGeometryBuffer::FreeIndices(const Allocation& allocation) { Free(m_IndexPages, allocation); }
+
+VulkanGeometryBuffer::Allocation VulkanGeometryBuffer::Allocate(DynamicArray<Page>& pages, const void* data, uint64_t size, uint64_t alignment, VkBufferUsageFlags usage,
+                                                                uint64_t pageSize) {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  Allocation allocation = {0, 0, size};
+  for (; allocation.Page < pages.size(); allocation.Page++) {
+    auto offset = pages[allocation.Page].Allocator.Allocate(size, alignment);
+    if (!offset) continue;
+
+    allocation.Offset = *offset;
+    break;
+  }
+
+  if (allocation.Page == pages.size()) {
+    auto newPageSize = std::max(pageSize, size);
+    HY_LOG_DEBUG("Allocating geometry buffer page {} of {} bytes", pages.size(), newPageSize);
+    pages.push_back({NewScopePointer<VulkanBuffer>(m_RenderDevice, newPageSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
+                     BufferAllocator(newPageSize)});
+    allocation.Offset = *pages.back().Allocator.Allocate(size, alignment);
+  }
+
+  if (m_UploadBatchDepth > 0) {
+    m_PendingUploads.push_back({pages[allocation.Page].Buffer->GetBuffer(), m_UploadData.size(), allocation.Offset, size});
+    m_UploadData.insert(m_UploadData.end(), static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+  } else {
+    pages[allocation.Page].Buffer->Upload(data, size, allocation.Offset);
+  }
+  return allocation;
+}
+
+void VulkanGeometryBuffer::Free(DynamicArray<Page>& pages, const Allocation& allocation) {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_PendingFrees.push_back({&pages, allocation, MAX_FRAMES_IN_FLIGHT + 1});
+}
+
+VulkanGeometryVertexBuffer::VulkanGeometryVertexBuffer(const ReferencePointer<VulkanGeometryBuffer>& geometryBuffer, const VulkanGeometryBuffer::Allocation& allocation)
+    : m_GeometryBuffer(geometryBuffer), m_Allocation(allocation), m_Buffer(geometryBuffer->GetVertexPage(allocation.Page)) {}
+
+VulkanGeometryVertexBuffer::~VulkanGeometryVertexBuffer() { m_GeometryBuffer->FreeVertices(m_Allocation); }
+
+void VulkanGeometryVertexBuffer::Bind(const ReferencePointer<CommandBuffer>& commandBuffer) const {
+  ZoneScoped;
+  std::dynamic_pointer_cast<VulkanCommandBuffer>(commandBuffer)->BindVertexBuffer(m_Buffer);
+}
+
+VulkanGeometryIndexBuffer::VulkanGeometryIndexBuffer(const ReferencePointer<VulkanGeometryBuffer>& geometryBuffer, const VulkanGeometryBuffer::Allocation& allocation,
+                                                     IndexType type)
+    : m_GeometryBuffer(geometryBuffer), m_Allocation(allocation), m_Buffer(geometryBuffer->GetIndexPage(allocation.Page)), m_Type(type) {}
+
+VulkanGeometryIndexBuffer::~VulkanGeometryIndexBuffer() { m_GeometryBuffer->FreeIndices(m_Allocation); }
+
+void VulkanGeometryIndexBuffer::Bind(const ReferencePointer<CommandBuffer>& commandBuffer) const {
+  ZoneScoped;
+  std::dynamic_pointer_cast<VulkanCommandBuffer>(commandBuffer)->BindIndexBuffer(m_Buffer, m_Type == IndexType::UInt16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32);
+}
@@ -16,7 +16,7 @@ using namespace Hydrogen::Vulkan;
 using namespace Hydrogen;
 
 namespace Hydrogen::Vulkan::Utils {
-static VkFormat ShaderDataTypeToVkFormat(ShaderDataType type) {
+static VkFormat ShaderDataTypeToVkFormat(ShaderDataType type, bool normalized) {
   switch (type) {
     case ShaderDataType::None:
       HY_INVOKE_ERROR("Invalid ShaderDataType value (ShaderDataType::None)!");
@@ -53,11 +53,54 @@ static VkFormat ShaderDataTypeToVkFormat(ShaderDataType type) {
     case ShaderDataType::Bool:
       HY_INVOKE_ERROR("ShaderDataType::Bool is not supported for vulkan shader input!");
       break;
+    case ShaderDataType::Half2:
+      return VK_FORMAT_R16G16_SFLOAT;
+      break;
+    case ShaderDataType::Half4:
+      return VK_FORMAT_R16G16B16A16_SFLOAT;
+      break;
+    case ShaderDataType::Byte4:
+      return normalized ? VK_FORMAT_R8G8B8A8_SNORM : VK_FORMAT_R8G8B8A8_SINT;
+      break;
+    case ShaderDataType::UByte4:
+      return normalized ? VK_FORMAT_R8G8B8A8_UNORM : VK_FORMAT_R8G8B8A8_UINT;
+      break;
+    case ShaderDataType::Short2:
+      return normalized ? VK_FORMAT_R16G16_SNORM : VK_FORMAT_R16G16_SINT;
+      break;
+    case ShaderDataType::Short4:
+      return normalized ? VK_FORMAT_R16G16B16A16_SNORM : VK_FORMAT_R16G16B16A16_SINT;
+      break;
+    case ShaderDataType::UShort2:
+      return normalized ? VK_FORMAT_R16G16_UNORM : VK_FORMAT_R16G16_UINT;
+      break;
+    case ShaderDataType::UShort4:
+      return normalized ? VK_FORMAT_R16G16B16A16_UNORM : VK_FORMAT_R16G16B16A16_UINT;
+      break;
+    case ShaderDataType::UInt1010102:
+      // The signed variant is optional for vertex input, the unsigned one is required by the spec
+      return normalized ? VK_FORMAT_A2B10G10R10_UNORM_PACK32 : VK_FORMAT_A2B10G10R10_UINT_PACK32;
+      break;
     default:
       HY_INVOKE_ERROR("Invalid ShaderDataType value!");
   }
 }
 
+static bool IsIntegerShaderDataType(ShaderDataType type) {
+  switch (type) {
+    case ShaderDataType::Byte4:
+    case ShaderDataType::UByte4:
+    case ShaderDataType::Short2:
+    case ShaderDataType::Short4:
+    case ShaderDataType::UShort2:
+    case ShaderDataType::UShort4:
+    case ShaderDataType::UInt1010102:
+      return true;
+    default:
+      return false;
+  }
+}
+
 static VkShaderStageFlags ShaderStageToVkShaderStageFlags(ShaderStage stage) {
   switch (stage) {
     case ShaderStage::VertexShader:
@@ -160,10 +203,10 @@ VulkanShader::VulkanShader(const ReferencePointer<RenderDevice>& renderDevice, c
   const auto& elements = vertexLayout.GetElements();
   DynamicArray<VkVertexInputAttributeDescription> attributeDescriptions(elements.size());
   for (size_t i = 0; i < elements.size(); i++) {
-    HY_ASSERT(!elements[i].Normalized, "Normalization of vertex input is not supported in vulkan!");
+    HY_ASSERT(!elements[i].Normalized || Utils::IsIntegerShaderDataType(elements[i].Type), "Vertex input element '{}' can not be normalized!", elements[i].Name);
     attributeDescriptions[i].binding = 0;
     attributeDescriptions[i].location = static_cast<uint32_t>(i);
-    attributeDescriptions[i].format = Utils::ShaderDataTypeToVkFormat(elements[i].Type);
+    attributeDescriptions[i].format = Utils::ShaderDataTypeToVkFormat(elements[i].Type, elements[i].Normalized);
     attributeDescriptions[i].offset = static_cast<uint32_t>(elements[i].Offset);
   }
 
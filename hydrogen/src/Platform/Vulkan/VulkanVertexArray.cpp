@@ -26,10 +26,12 @@ void VulkanVertexArray::AddVertexBuffer(const ReferencePointer<VertexBuffer>& ve
   HY_ASSERT(m_VertexBuffers.size() == 0, "Multiple vertex buffers per vertex array are unimplemented!");
 
   m_VertexBuffers.push_back(vertexBuffer);
+  m_VertexOffset = static_cast<int32_t>(vertexBuffer->GetOffset() / vertexBuffer->GetLayout().GetStride());
 }
 
 void VulkanVertexArray::SetIndexBuffer(const ReferencePointer<IndexBuffer>& indexBuffer) {
   ZoneScoped;
-  
+
   m_IndexBuffer = indexBuffer;
+  m_FirstIndex = static_cast<uint32_t>(indexBuffer->GetOffset() / Hydrogen::Utils::IndexTypeSize(indexBuffer->GetIndexType()));
 }
@@ -7,7 +7,7 @@
 
 using namespace Hydrogen;
 
-ReferencePointer<VertexBuffer> VertexBuffer::Create(const ReferencePointer<RenderDevice>& device, float* vertices, size_t size) {
+ReferencePointer<VertexBuffer> VertexBuffer::Create(const ReferencePointer<RenderDevice>& device, const void* vertices, size_t size) {
   ZoneScoped;
   switch (Renderer::GetAPI()) {
     case RendererAPI::API::Vulkan:
@@ -20,11 +20,11 @@ ReferencePointer<VertexBuffer> VertexBuffer::Create(const ReferencePointer<Rende
   return nullptr;
 }
 
-ReferencePointer<IndexBuffer> IndexBuffer::Create(const ReferencePointer<RenderDevice>& device, uint32_t* indices, size_t size) {
+ReferencePointer<IndexBuffer> IndexBuffer::Create(const ReferencePointer<RenderDevice>& device, const void* indices, size_t size, IndexType type) {
   ZoneScoped;
   switch (Renderer::GetAPI()) {
     case RendererAPI::API::Vulkan:
-      return NewReferencePointer<Vulkan::VulkanIndexBuffer>(device, indices, size);
+      return NewReferencePointer<Vulkan::VulkanIndexBuffer>(device, indices, size, type);
     default:
       HY_ASSERT_CHECK(false,
                       "Invalid renderer API value returned from "
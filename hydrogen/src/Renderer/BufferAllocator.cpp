@@ -0,0 +1,61 @@
+#include <Hydrogen/Renderer/BufferAllocator.hpp>
+#include <Hydrogen/Core/Assert.hpp>
+
+using namespace Hydrogen;
+
+BufferAllocator::BufferAllocator(uint64_t size) : m_Size(size) {
+  if (size) InsertFreeRange(0, size);
+}
+
+std::optional<uint64_t> BufferAllocator::Allocate(uint64_t size, uint64_t alignment) {
+  HY_ASSERT(size != 0 && alignment != 0, "Buffer allocations must have a size and an alignment!");
+
+  // The smallest range that fits wins, the alignment padding can make a range too small so the search continues with the larger ones
+  for (auto it = m_FreeRangesBySize.lower_bound({size, 0}); it != m_FreeRangesBySize.end(); ++it) {
+    auto [rangeSize, rangeOffset] = *it;
+    auto offset = (rangeOffset + alignment - 1) / alignment * alignment;
+    if (offset - rangeOffset + size > rangeSize) continue;
+
+    EraseFreeRange(m_FreeRanges.find(rangeOffset));
+    if (offset > rangeOffset) InsertFreeRange(rangeOffset, offset - rangeOffset);
+    if (rangeOffset + rangeSize > offset + size) InsertFreeRange(offset + size, rangeOffset + rangeSize - offset - size);
+
+    m_UsedSize += size;
+    return offset;
+  }
+
+  return std::nullopt;
+}
+
+void BufferAllocator::Free(uint64_t offset, uint64_t size) {
+  HY_ASSERT(offset + size <= m_Size && size <= m_UsedSize, "Freed range was not allocated from this allocator!");
+  m_UsedSize -= size;
+
+  auto next = m_FreeRanges.lower_bound(offset);
+  if (next != m_FreeRanges.end() && next->first == offset + size) {
+    size += next->second;
+    next = std::next(next);
+    EraseFreeRange(std::prev(next));
+  }
+
+  if (next != m_FreeRanges.begin()) {
+    auto previous = std::prev(next);
+    if (previous->first + previous->second == offset) {
+      offset = previous->first;
+      size += previous->second;
+      EraseFreeRange(previous);
+    }
+  }
+
+  InsertFreeRange(offset, size);
+}
+
+void BufferAllocator::InsertFreeRange(uint64_t offset, uint64_t size) {
+  m_FreeRanges.emplace(offset, size);
+  m_FreeRangesBySize.emplace(size, offset);
+}
+
+void BufferAllocator::EraseFreeRange(std::map<uint64_t, uint64_t>::iterator range) {
+  m_FreeRangesBySize.erase({range->second, range->first});
+  m_FreeRanges.erase(range);
+}
@@ -0,0 +1,21 @@
+#include <Hydrogen/Renderer/GeometryBuffer.hpp>
+#include <Hydrogen/Renderer/Renderer.hpp>
+#include <Hydrogen/Renderer/RendererAPI.hpp>
+#include <Hydrogen/Platform/Vulkan/VulkanGeometryBuffer.hpp>
+#include <Hydrogen/Core/Assert.hpp>
+#include <tracy/Tracy.hpp>
+
+using namespace Hydrogen;
+
+ReferencePointer<GeometryBuffer> GeometryBuffer::Create(const ReferencePointer<RenderDevice>& device, size_t vertexPageSize, size_t indexPageSize) {
+  ZoneScoped;
+  switch (Renderer::GetAPI()) {
+    case RendererAPI::API::Vulkan:
+      return NewReferencePointer<Vulkan::VulkanGeometryBuffer>(device, vertexPageSize, indexPageSize);
+    default:
+      HY_ASSERT_CHECK(false,
+                      "Invalid renderer API value returned from "
+                      "Renderer::GetRendererAPI()");
+  }
+  return nullptr;
+}
@@ -0,0 +1,246 @@
+#include <Hydrogen/Renderer/MeshStreaming.hpp>
+#include <Hydrogen/Renderer/GeometryBuffer.hpp>
+#include <Hydrogen/Renderer/Renderer.hpp>
+#include <Hydrogen/Renderer/VertexArray.hpp>
+#include <Hydrogen/Core/Assert.hpp>
+#include <Hydrogen/Core/JobSystem.hpp>
+#include <Hydrogen/Scene/Scene.hpp>
+#include <Hydrogen/Scene/Entity.hpp>
+#include <Hydrogen/Scene/Components.hpp>
+#include <algorithm>
+#include <cstring>
+#include <tracy/Tracy.hpp>
+
+using namespace Hydrogen;
+
+namespace Hydrogen::Utils {
+// Prefixes that fit into 16 bits upload their indices narrowed, so the coarse levels of large meshes get them as well. 0xffff stays unused so it can
+// never be mistaken for a primitive restart
+static IndexType GetPrefixIndexType(uint32_t vertexCount) { return vertexCount > std::numeric_limits<uint16_t>::max() ? IndexType::UInt32 : IndexType::UInt16; }
+
+static DynamicArray<uint8_t> PackIndices(const DynamicArray<uint32_t>& indices, IndexType type) {
+  DynamicArray<uint8_t> data(indices.size() * IndexTypeSize(type));
+  if (type == IndexType::UInt32) {
+    std::memcpy(data.data(), indices.data(), data.size());
+    return data;
+  }
+
+  auto narrowed = reinterpret_cast<uint16_t*>(data.data());
+  for (size_t i = 0; i < indices.size(); i++) narrowed[i] = static_cast<uint16_t>(indices[i]);
+  return data;
+}
+}  // namespace Hydrogen::Utils
+
+uint64_t MeshStreaming::s_Budget = 256ULL * 1024 * 1024;
+uint32_t MeshStreaming::s_MaxPendingLoads = 4;
+DynamicArray<std::weak_ptr<StreamedMesh>> MeshStreaming::s_Meshes;
+DynamicArray<ReferencePointer<StreamedMesh>> MeshStreaming::s_ActiveMeshes;
+uint64_t MeshStreaming::s_Frame = 0;
+uint32_t MeshStreaming::s_PendingLoads = 0;
+MeshStreamingStats MeshStreaming::s_Stats;
+DynamicArray<MeshStreaming::CompletedLoad> MeshStreaming::s_CompletedLoads;
+std::mutex MeshStreaming::s_CompletedLoadsMutex;
+
+StreamedMesh::StreamedMesh(const StreamedMeshDescription& description, const ReferencePointer<VertexArray>& coarsest)
+    : m_Description(description), m_Coarsest(coarsest), m_ResidentLevel(GetCoarsestLevel()), m_RequestedLevel(GetCoarsestLevel()) {}
+
+uint64_t StreamedMesh::GetLevelSize(uint32_t level) const {
+  const auto& prefix = m_Description.Levels[level];
+  return static_cast<uint64_t>(prefix.VertexCount) * m_Description.VertexStride +
+         static_cast<uint64_t>(prefix.IndexCount) * Utils::IndexTypeSize(Utils::GetPrefixIndexType(prefix.VertexCount));
+}
+
+void StreamedMesh::Request(uint32_t level, float screenSize, uint64_t frame) {
+  level = std::min(level, GetCoarsestLevel());
+  if (m_RequestFrame != frame) {
+    m_RequestFrame = frame;
+    m_RequestedLevel = level;
+    m_ScreenSize = screenSize;
+    return;
+  }
+
+  m_RequestedLevel = std::min(m_RequestedLevel, level);
+  m_ScreenSize = std::max(m_ScreenSize, screenSize);
+}
+
+ReferencePointer<StreamedMesh> MeshStreaming::CreateMesh(const StreamedMeshDescription& description) {
+  ZoneScoped;
+  HY_ASSERT(!description.Levels.empty() && description.ReadLevel, "Streamed meshes need at least one level and a function reading them!");
+
+  auto coarsest = static_cast<uint32_t>(description.Levels.size() - 1);
+  auto geometry = description.ReadLevel(coarsest);
+  auto indexType = Utils::GetPrefixIndexType(description.Levels[coarsest].VertexCount);
+  auto vertexArray = CreateVertexArray(description, geometry.Vertices, Utils::PackIndices(geometry.Indices, indexType), indexType);
+
+  auto mesh = NewReferencePointer<StreamedMesh>(description, vertexArray);
+  s_Meshes.push_back(mesh);
+  return mesh;
+}
+
+void MeshStreaming::Update(Scene& scene) {
+  ZoneScoped;
+  s_Frame++;
+
+  InstallCompletedLoads();
+
+  auto registry = scene.GetRegistry();
+  for (auto entityHandle : registry->view<MeshRendererComponent, LODComponent>()) {
+    const auto& lod = registry->get<LODComponent>(entityHandle);
+    for (const auto& subMesh : registry->get<MeshRendererComponent>(entityHandle).SubMeshes) {
+      if (subMesh.Stream) subMesh.Stream->Request(lod.Level, lod.ScreenSize, s_Frame);
+    }
+  }
+
+  // Meshes without any reference left gave their geometry back to the geometry buffer when they were destroyed
+  s_ActiveMeshes.clear();
+  uint64_t usage = 0;
+  for (const auto& weakMesh : s_Meshes) {
+    if (auto mesh = weakMesh.lock()) {
+      usage += mesh->GetMemoryUsage();
+      s_ActiveMeshes.push_back(std::move(mesh));
+    }
+  }
+  std::erase_if(s_Meshes, [](const std::weak_ptr<StreamedMesh>& mesh) { return mesh.expired(); });
+
+  DynamicArray<ReferencePointer<StreamedMesh>> loads;
+  DynamicArray<ReferencePointer<StreamedMesh>> victims;
+  DynamicArray<ReferencePointer<StreamedMesh>> shrinks;
+  for (const auto& mesh : s_ActiveMeshes) {
+    auto requestedLevel = mesh->GetRequestedLevel(s_Frame);
+    if (requestedLevel <= mesh->m_ResidentLevel) mesh->m_UsedFrame = s_Frame;
+
+    bool expired = s_Frame - mesh->m_UsedFrame > s_EvictionDelay;
+    if (requestedLevel < mesh->m_ResidentLevel && mesh->m_PendingLevel == StreamedMesh::s_NoLevel) {
+      loads.push_back(mesh);
+    } else if (requestedLevel > mesh->m_ResidentLevel && requestedLevel == mesh->GetCoarsestLevel()) {
+      if (expired) {
+        usage -= Evict(*mesh);
+      } else {
+        victims.push_back(mesh);
+      }
+    } else if (requestedLevel > mesh->m_ResidentLevel && expired && mesh->m_PendingLevel == StreamedMesh::s_NoLevel) {
+      // Dropping to the coarsest level would stream the requested level right back in, so the smaller prefix replaces the resident one instead
+      shrinks.push_back(mesh);
+    }
+  }
+
+  // The meshes covering the most of the viewport are loaded first, the space is taken from the levels that were needed the longest time ago
+  std::sort(loads.begin(), loads.end(), [](const auto& a, const auto& b) { return a->m_ScreenSize > b->m_ScreenSize; });
+  std::sort(victims.begin(), victims.end(), [](const auto& a, const auto& b) {
+    return a->m_UsedFrame != b->m_UsedFrame ? a->m_UsedFrame < b->m_UsedFrame : a->m_ScreenSize < b->m_ScreenSize;
+  });
+
+  size_t nextVictim = 0;
+  for (const auto& mesh : loads) {
+    if (s_PendingLoads >= s_MaxPendingLoads) break;
+
+    auto level = mesh->GetRequestedLevel(s_Frame);
+    while (usage + mesh->GetLevelSize(level) > s_Budget && nextVictim < victims.size()) usage -= Evict(*victims[nextVictim++]);
+    // A coarser level than requested is still better than the resident one
+    while (level < mesh->m_ResidentLevel && usage + mesh->GetLevelSize(level) > s_Budget) level++;
+    if (level == mesh->m_ResidentLevel) continue;
+
+    usage += mesh->GetLevelSize(level);
+    StartLoad(mesh, level);
+  }
+
+  for (const auto& mesh : shrinks) {
+    if (s_PendingLoads >= s_MaxPendingLoads) break;
+
+    auto level = mesh->GetRequestedLevel(s_Frame);
+    usage += mesh->GetLevelSize(level);
+    StartLoad(mesh, level);
+    s_Stats.EvictedLevels++;
+  }
+
+  s_Stats.Budget = s_Budget;
+  s_Stats.ResidentBytes = usage;
+  s_Stats.MeshCount = static_cast<uint32_t>(s_ActiveMeshes.size());
+  s_Stats.PendingLoads = s_PendingLoads;
+}
+
+void MeshStreaming::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(s_CompletedLoadsMutex);
+    s_CompletedLoads.clear();
+  }
+
+  s_ActiveMeshes.clear();
+  s_Meshes.clear();
+  s_PendingLoads = 0;
+  s_Stats = {};
+}
+
+ReferencePointer<VertexArray> MeshStreaming::CreateVertexArray(const StreamedMeshDescription& description, const DynamicArray<uint8_t>& vertices,
+                                                               const DynamicArray<uint8_t>& indices, IndexType indexType) {
+  const auto& geometryBuffer = Renderer::GetGeometryBuffer();
+  HY_ASSERT(geometryBuffer, "No geometry buffer set for uploading streamed meshes!");
+
+  auto vertexBuffer = geometryBuffer->AllocateVertices(vertices.data(), vertices.size(), description.VertexStride);
+  vertexBuffer->SetLayout(description.Layout);
+  auto vertexArray = VertexArray::Create();
+  vertexArray->AddVertexBuffer(vertexBuffer);
+  vertexArray->SetIndexBuffer(geometryBuffer->AllocateIndices(indices.data(), indices.size(), indexType));
+  return vertexArray;
+}
+
+void MeshStreaming::InstallCompletedLoads() {
+  ZoneScoped;
+
+  DynamicArray<CompletedLoad> completedLoads;
+  {
+    std::lock_guard<std::mutex> lock(s_CompletedLoadsMutex);
+    completedLoads.swap(s_CompletedLoads);
+  }
+  if (completedLoads.empty()) return;
+
+  // The vertex arrays are only drawn after the batch was submitted
+  DynamicArray<ReferencePointer<VertexArray>> vertexArrays;
+  Renderer::GetGeometryBuffer()->BeginUploads();
+  for (const auto& load : completedLoads) vertexArrays.push_back(CreateVertexArray(load.Mesh->m_Description, load.Vertices, load.Indices, load.IndexFormat));
+  Renderer::GetGeometryBuffer()->SubmitUploads();
+
+  // The replaced vertex array gives its ranges back once no frame in flight draws from them anymore
+  for (size_t i = 0; i < completedLoads.size(); i++) {
+    auto& mesh = *completedLoads[i].Mesh;
+    mesh.m_Resident = vertexArrays[i];
+    mesh.m_ResidentLevel = completedLoads[i].Level;
+    mesh.m_ResidentSize = mesh.m_PendingSize;
+    mesh.m_PendingLevel = StreamedMesh::s_NoLevel;
+    mesh.m_PendingSize = 0;
+  }
+
+  s_PendingLoads -= static_cast<uint32_t>(completedLoads.size());
+  s_Stats.LoadedLevels += completedLoads.size();
+}
+
+void MeshStreaming::StartLoad(const ReferencePointer<StreamedMesh>& mesh, uint32_t level) {
+  mesh->m_PendingLevel = level;
+  mesh->m_PendingSize = mesh->GetLevelSize(level);
+  s_PendingLoads++;
+
+  JobSystem::Execute([mesh, level]() {
+    ZoneScoped;
+    const auto& prefix = mesh->m_Description.Levels[level];
+    auto geometry = mesh->m_Description.ReadLevel(level);
+    HY_ASSERT(geometry.Vertices.size() == static_cast<size_t>(prefix.VertexCount) * mesh->m_Description.VertexStride && geometry.Indices.size() == prefix.IndexCount,
+              "Streamed level {} does not match its description!", level);
+
+    CompletedLoad load = {mesh, level, std::move(geometry.Vertices), {}, Utils::GetPrefixIndexType(prefix.VertexCount)};
+    load.Indices = Utils::PackIndices(geometry.Indices, load.IndexFormat);
+
+    std::lock_guard<std::mutex> lock(s_CompletedLoadsMutex);
+    s_CompletedLoads.push_back(std::move(load));
+  });
+}
+
+uint64_t MeshStreaming::Evict(StreamedMesh& mesh) {
+  if (!mesh.m_Resident) return 0;
+
+  auto size = mesh.m_ResidentSize;
+  mesh.m_Resident.reset();
+  mesh.m_ResidentLevel = mesh.GetCoarsestLevel();
+  mesh.m_ResidentSize = 0;
+  s_Stats.EvictedLevels++;
+  return size;
+}
@@ -0,0 +1,38 @@
+#include <Hydrogen/Renderer/Meshlet.hpp>
+#include <array>
+#include <tracy/Tracy.hpp>
+
+using namespace Hydrogen;
+
+namespace Hydrogen::Utils {
+// Gribb and Hartmann, the planes of the clip volume expressed in the space the matrix transforms from, with normals pointing inside
+static std::array<glm::vec4, 6> ExtractFrustumPlanes(const glm::mat4& matrix) {
+  auto row = [&matrix](int i) { return glm::vec4(matrix[0][i], matrix[1][i], matrix[2][i], matrix[3][i]); };
+
+  std::array<glm::vec4, 6> planes = {row(3) + row(0), row(3) - row(0), row(3) + row(1), row(3) - row(1), row(3) + row(2), row(3) - row(2)};
+  for (auto& plane : planes) plane /= glm::length(glm::vec3(plane));
+  return planes;
+}
+}  // namespace Hydrogen::Utils
+
+void MeshletCulling::Cull(const DynamicArray<Meshlet>& meshlets, const glm::mat4& modelViewProjection, const glm::vec3& cameraPosition, DynamicArray<IndexRange>& ranges) {
+  ZoneScoped;
+
+  auto planes = Utils::ExtractFrustumPlanes(modelViewProjection);
+  auto firstRange = ranges.size();
+
+  for (const auto& meshlet : meshlets) {
+    bool visible = true;
+    for (const auto& plane : planes) visible &= glm::dot(glm::vec3(plane), meshlet.Center) + plane.w >= -meshlet.Radius;
+    if (!visible) continue;
+
+    auto offset = meshlet.Center - cameraPosition;
+    if (glm::dot(offset, meshlet.ConeAxis) >= meshlet.ConeCutoff * glm::length(offset) + meshlet.Radius) continue;
+
+    if (ranges.size() > firstRange && ranges.back().FirstIndex + ranges.back().IndexCount == meshlet.FirstIndex) {
+      ranges.back().IndexCount += meshlet.IndexCount;
+    } else {
+      ranges.push_back({meshlet.FirstIndex, meshlet.IndexCount});
+    }
+  }
+}
@@ -2,6 +2,8 @@
 #include <Hydrogen/Renderer/Buffer.hpp>
 #include <Hydrogen/Renderer/SwapChain.hpp>
 #include <Hydrogen/Renderer/Framebuffer.hpp>
+#include <Hydrogen/Renderer/GeometryBuffer.hpp>
+#include <Hydrogen/Renderer/MeshStreaming.hpp>
 #include <Hydrogen/Renderer/CommandBuffer.hpp>
 #include <Hydrogen/Renderer/VertexArray.hpp>
 #include <Hydrogen/Renderer/RenderWindow.hpp>
@@ -25,6 +27,7 @@ struct UniformBufferObject {
 };
 
 ReferencePointer<Context> Renderer::s_Context;
+ReferencePointer<GeometryBuffer> Renderer::s_GeometryBuffer;
 uint32_t Renderer::s_MaxFramesInFlight = MAX_FRAMES_IN_FLIGHT;
 
 Renderer::Renderer(const ReferencePointer<RenderWindow>& window, const ReferencePointer<RenderDevice>& device, const ScopePointer<class Scene>& scene)
@@ -36,6 +39,38 @@ Renderer::Renderer(const ReferencePointer<RenderWindow>& window, const Reference
   m_Texture = AssetManager::Get<SpriteAsset>("assets/Meshes/viking_room.png")->CreateTexture2D(m_Device);
   m_UniformBuffer = UniformBuffer::Create(m_Device, sizeof(UniformBufferObject));
 
+  CreateShader(AssetManager::Get<ShaderAsset>("assets/Raw.glsl"));
+
+  // Hot reloaded assets are swapped in at a frame boundary, the pipeline is rebuilt with the new resources
+  m_ReloadCallbacks.push_back(AssetManager::AddReloadCallback("assets/Raw.glsl", [this](const ReferencePointer<Asset>& asset) {
+    CreateShader(AssetCast<ShaderAsset>(asset));
+  }));
+  m_ReloadCallbacks.push_back(AssetManager::AddReloadCallback("assets/Meshes/viking_room.png", [this](const ReferencePointer<Asset>& asset) {
+    Retire(m_Texture);
+    m_Texture = AssetCast<SpriteAsset>(asset)->CreateTexture2D(m_Device);
+    CreateShader(m_ShaderAsset);
+  }));
+
+  m_CommandBuffers.resize(s_MaxFramesInFlight);
+  for (uint32_t i = 0; i < s_MaxFramesInFlight; i++) {
+    m_CommandBuffers[i] = CommandBuffer::Create(device);
+  }
+
+  m_CurrentFrame = 0;
+
+  HY_LOG_INFO("Initialized renderer");
+}
+
+Renderer::~Renderer() {
+  for (auto id : m_ReloadCallbacks) {
+    AssetManager::RemoveReloadCallback(id);
+  }
+  m_Device->WaitForIdle();
+}
+
+void Renderer::CreateShader(const ReferencePointer<ShaderAsset>& shaderAsset) {
+  ZoneScoped;
+
   ShaderDependency uniformBuffer{};
   uniformBuffer.Type = ShaderDependencyType::UniformBuffer;
   uniformBuffer.Stage = ShaderStage::VertexShader;
@@ -48,31 +83,30 @@ Renderer::Renderer(const ReferencePointer<RenderWindow>& window, const Reference
   texture.Location = 1;
   texture.Texture = m_Texture;
 
-  m_Shader = AssetManager::Get<ShaderAsset>("assets/Raw.glsl")
-                 ->CreateShader(device, m_SwapChain, m_Framebuffer,
-                         {{ShaderDataType::Float3, "Position", false}, {ShaderDataType::Float3, "Normal", false}, {ShaderDataType::Float2, "TexCoords", false}}, {uniformBuffer, texture});
-
-  m_CommandBuffers.resize(s_MaxFramesInFlight);
-  for (uint32_t i = 0; i < s_MaxFramesInFlight; i++) {
-    m_CommandBuffers[i] = CommandBuffer::Create(device);
-  }
-
-  m_CurrentFrame = 0;
-
-  HY_LOG_INFO("Initialized renderer");
+  if (m_Shader) Retire(m_Shader);
+  m_ShaderAsset = shaderAsset;
+  m_Shader = shaderAsset->CreateShader(m_Device, m_SwapChain, m_Framebuffer, MeshAsset::GetVertexLayout(), {uniformBuffer, texture});
 }
 
-Renderer::~Renderer() { m_Device->WaitForIdle(); }
+void Renderer::Retire(const ReferencePointer<void>& resource) {
+  // The slot of the current frame is reused after s_MaxFramesInFlight frames, one more frame covers the frame that is being recorded
+  m_RetiredResources.push_back({resource, s_MaxFramesInFlight + 1});
+}
 
 void Renderer::Render() {
+  for (auto& retired : m_RetiredResources) retired.FramesLeft--;
+  std::erase_if(m_RetiredResources, [](const RetiredResource& retired) { return retired.FramesLeft == 0; });
+  if (s_GeometryBuffer) s_GeometryBuffer->NextFrame();
+
   static auto startTime = std::chrono::high_resolution_clock::now();
 
   auto currentTime = std::chrono::high_resolution_clock::now();
   float time = std::chrono::duration<float, std::chrono::seconds::period>(currentTime - startTime).count();
 
   UniformBufferObject ubo{};
+  auto cameraPosition = glm::vec3(2.0f, 2.0f, 2.0f);
   ubo.Model = glm::rotate(glm::mat4(1.0f), time * glm::radians(20.0f), glm::vec3(0.0f, 0.0f, 1.0f));
-  ubo.View = glm::lookAt(glm::vec3(2.0f, 2.0f, 2.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+  ubo.View = glm::lookAt(cameraPosition, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
   const auto& viewportSize = m_RenderWindow->GetViewportSize();
   ubo.Proj = glm::perspective(glm::radians(45.0f), viewportSize.x / viewportSize.y, 0.001f, 1000.0f);
   ubo.Proj[1][1] *= -1;
@@ -80,10 +114,26 @@ void Renderer::Render() {
   m_UniformBuffer->SetData(&ubo);
   const auto& commandBuffer = m_CommandBuffers[m_CurrentFrame];
 
+  m_Scene->UpdateBounds();
+  m_Scene->UpdateLevelsOfDetail(cameraPosition, ubo.Proj);
+  MeshStreaming::Update(*m_Scene);
+
   auto entities = m_Scene->GetEntitiesByName("Room");
   auto children = entities[0].GetChildrenByName("mesh_all1_Texture1_0");
   auto& entity = children[0];
-  auto& vertexArray = entity.GetComponent<MeshRendererComponent>().VertexArrays[0];
+  auto& subMesh = entity.GetComponent<MeshRendererComponent>().SubMeshes[0];
+  auto levelIndex = subMesh.GetResidentLevel(entity.HasComponent<LODComponent>() ? entity.GetComponent<LODComponent>().Level : 0);
+  const auto& level = subMesh.GetLevel(levelIndex);
+  const auto& vertexArray = subMesh.GetVertexArray();
+
+  // Meshlets only exist for the full resolution level, the coarser levels are cheap enough to draw whole
+  m_VisibleRanges.clear();
+  if (levelIndex == 0 && !subMesh.Meshlets.empty()) {
+    auto objectSpaceCameraPosition = glm::vec3(glm::inverse(ubo.Model) * glm::vec4(cameraPosition, 1.0f));
+    MeshletCulling::Cull(subMesh.Meshlets, ubo.Proj * ubo.View * ubo.Model, objectSpaceCameraPosition, m_VisibleRanges);
+  } else {
+    m_VisibleRanges.push_back({level.FirstIndex, level.IndexCount});
+  }
 
   commandBuffer->Reset();
   m_SwapChain->AcquireNextImage(commandBuffer);
@@ -96,7 +146,7 @@ void Renderer::Render() {
 
     commandBuffer->CmdSetViewport(m_SwapChain);
     commandBuffer->CmdSetScissor(m_SwapChain);
-    commandBuffer->CmdDrawIndexed(vertexArray);
+    for (const auto& range : m_VisibleRanges) commandBuffer->CmdDrawIndexed(vertexArray, range.IndexCount, range.FirstIndex);
 
     commandBuffer->CmdDrawImGuiDrawData();
   }
@@ -1,5 +1,6 @@
 #include <Hydrogen/Renderer/ShaderCompiler.hpp>
 #include <Hydrogen/Core/Assert.hpp>
+#include <glslang/build_info.h>
 
 using namespace Hydrogen;
 
@@ -120,7 +121,7 @@ const TBuiltInResource DefaultTBuiltInResource = {
         /* .generalConstantMatrixVectorIndexing = */ 1,
     }};
 
-ShaderCompiler::ShaderCompiler(ShaderLanguage frontEnd, ShaderClient client, SpriVVersion spirvVersion, ShaderStage stage, uint32_t version) : m_Version(version) {
+ShaderCompiler::ShaderCompiler(ShaderLanguage frontEnd, ShaderClient client, SpriVVersion spirvVersion, ShaderStage stage, uint32_t version) : m_Version(version), m_Language(frontEnd), m_Client(client), m_SpirvTarget(spirvVersion), m_Stage(stage) {
   glslang_initialize_process();
 
   switch (frontEnd) {
@@ -207,7 +208,7 @@ ShaderCompiler::~ShaderCompiler() {
   glslang_finalize_process();
 }
 
-void ShaderCompiler::AddShader(const String& source) {
+bool ShaderCompiler::AddShader(const String& source) {
   const glslang_input_t input = {
       .language = m_FrontEndLang,
       .stage = m_ShaderStage,
@@ -227,21 +228,38 @@ void ShaderCompiler::AddShader(const String& source) {
   glslang_shader_t* shader = glslang_shader_create(&input);
 
   if (!glslang_shader_preprocess(shader, &input)) {
-    HY_INVOKE_ERROR("Shader preprocessing failed:\n{}", glslang_shader_get_info_log(shader))
+    HY_LOG_ERROR("Shader preprocessing failed:\n{}", glslang_shader_get_info_log(shader));
+    glslang_shader_delete(shader);
+    return false;
   }
 
   if (!glslang_shader_parse(shader, &input)) {
-    HY_INVOKE_ERROR("Shader compilation failed:\n{}", glslang_shader_get_info_log(shader))
+    HY_LOG_ERROR("Shader compilation failed:\n{}", glslang_shader_get_info_log(shader));
+    glslang_shader_delete(shader);
+    return false;
   }
 
   glslang_program_add_shader(m_Program, shader);
   m_Shader.push_back(shader);
+  return true;
+}
+
+CacheKey ShaderCompiler::GetCacheKey() const {
+  CacheKey key;
+  key.Add(GetToolchainVersion()).Add(m_Language).Add(m_Client).Add(m_SpirvTarget).Add(m_Stage).Add(m_Version);
+  return key;
+}
+
+String ShaderCompiler::GetToolchainVersion() {
+  return "glslang " + std::to_string(GLSLANG_VERSION_MAJOR) + "." + std::to_string(GLSLANG_VERSION_MINOR) + "." + std::to_string(GLSLANG_VERSION_PATCH);
 }
 
-void ShaderCompiler::Link() {
+bool ShaderCompiler::Link() {
   if (!glslang_program_link(m_Program, GLSLANG_MSG_SPV_RULES_BIT | GLSLANG_MSG_VULKAN_RULES_BIT)) {
-    HY_INVOKE_ERROR("Shader linking failed:\n{}", glslang_program_get_info_log(m_Program))
+    HY_LOG_ERROR("Shader linking failed:\n{}", glslang_program_get_info_log(m_Program));
+    return false;
   }
+  return true;
 }
 
 DynamicArray<uint32_t> ShaderCompiler::GetSpriv() {
@@ -41,6 +41,14 @@ Entity Entity::CreateChild(const String& name) {
   return entity;
 }
 
+glm::mat4 Entity::GetWorldTransform() {
+  auto transform = GetComponent<TransformComponent>().GetTransform();
+  for (auto parent = GetComponent<HierarchyComponent>().Parent; parent.Exists(); parent = parent.GetComponent<HierarchyComponent>().Parent) {
+    transform = parent.GetComponent<TransformComponent>().GetTransform() * transform;
+  }
+  return transform;
+}
+
 Entity Entity::CreateChild(const String& name, const String& tag) {
   auto entity = m_Scene->CreateEntity(name, tag);
 
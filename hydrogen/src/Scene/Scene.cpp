@@ -1,20 +1,33 @@
 #include <Hydrogen/Scene/Scene.hpp>
 #include <Hydrogen/Scene/Entity.hpp>
 #include <Hydrogen/Scene/Components.hpp>
+#include <Hydrogen/Renderer/Camera.hpp>
 #include <Hydrogen/Core/UUID.hpp>
 #include <Hydrogen/Core/Assert.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tracy/Tracy.hpp>
 
 using namespace Hydrogen;
 
-Scene::Scene(const std::string& name) : m_Name(name), m_Registry() {}
+Scene::Scene(const std::string& name) : m_Name(name), m_EntityIndex(), m_Registry() {
+  m_Registry.on_construct<TagComponent>().connect<&Scene::OnTagComponentConstruct>(*this);
+  m_Registry.on_update<TagComponent>().connect<&Scene::OnTagComponentConstruct>(*this);
+  m_Registry.on_destroy<TagComponent>().connect<&Scene::OnTagComponentDestroy>(*this);
+}
 
-Scene::~Scene() {}
+Scene::~Scene() {
+  m_Registry.on_construct<TagComponent>().disconnect(*this);
+  m_Registry.on_update<TagComponent>().disconnect(*this);
+  m_Registry.on_destroy<TagComponent>().disconnect(*this);
+}
 
 Entity Scene::CreateEntity(const std::string& name) {
   auto entityHandle = m_Registry.create();
 
   Entity entity(this, entityHandle);
-  entity.AddComponent<TagComponent>(name).UUID = UUID().GetValue();
+  entity.AddComponent<TagComponent>(name, "", UUID().GetValue());
   entity.AddComponent<TransformComponent>();
   entity.AddComponent<HierarchyComponent>(Entity());
 
@@ -25,13 +38,30 @@ Entity Scene::CreateEntity(const std::string& name, const std::string& tag) {
   auto entityHandle = m_Registry.create();
 
   Entity entity(this, entityHandle);
-  entity.AddComponent<TagComponent>(name, tag).UUID = UUID().GetValue();
+  entity.AddComponent<TagComponent>(name, tag, UUID().GetValue());
   entity.AddComponent<TransformComponent>();
   entity.AddComponent<HierarchyComponent>(Entity());
 
   return entity;
 }
 
+DynamicArray<Entity> Scene::CreateEntities(const std::string& name, size_t count) {
+  auto uuids = UUID::Batch(count);
+
+  DynamicArray<Entity> entities;
+  entities.reserve(count);
+  m_EntityIndex.reserve(m_EntityIndex.size() + count);
+  for (size_t i = 0; i < count; i++) {
+    Entity entity(this, m_Registry.create());
+    entity.AddComponent<TagComponent>(name, "", uuids[i].GetValue());
+    entity.AddComponent<TransformComponent>();
+    entity.AddComponent<HierarchyComponent>(Entity());
+    entities.push_back(entity);
+  }
+
+  return entities;
+}
+
 void Scene::DestroyEntity(Entity entity) {
   HY_ASSERT(entity.GetScene() == this, "Entity is not present in this scene!");
   m_Registry.destroy(entity.GetEntityHandle());
@@ -73,3 +103,49 @@ DynamicArray<Entity> Scene::GetEntitiesByTag(const std::string& tag) {
 
   return entities;
 }
+
+Entity Scene::FindByUUID(uint64_t uuid) {
+  auto it = m_EntityIndex.find(uuid);
+  if (it == m_EntityIndex.end()) return Entity();
+
+  // The index is not updated when a TagComponent::UUID is modified in place, so verify the match
+  auto tag = m_Registry.try_get<TagComponent>(it->second);
+  if (!tag || tag->UUID != uuid) return Entity();
+
+  return {this, it->second};
+}
+
+void Scene::UpdateBounds() {
+  ZoneScoped;
+
+  for (auto entityHandle : m_Registry.view<BoundsComponent>()) {
+    Entity entity(this, entityHandle);
+    entity.GetComponent<BoundsComponent>().UpdateWorldBounds(entity.GetWorldTransform());
+  }
+}
+
+void Scene::UpdateLevelsOfDetail(const glm::vec3& cameraPosition, const glm::mat4& projection) {
+  ZoneScoped;
+
+  // proj[1][1] is cot(fov / 2), a sphere of radius r at distance d covers r * cot(fov / 2) / d of the viewport height
+  auto focalScale = std::abs(projection[1][1]);
+  for (auto entityHandle : m_Registry.view<LODComponent, BoundsComponent>()) {
+    Entity entity(this, entityHandle);
+    auto& lod = entity.GetComponent<LODComponent>();
+    const auto& bounds = entity.GetComponent<BoundsComponent>();
+
+    auto radius = bounds.WorldRadius;
+    auto distance = glm::length(bounds.WorldCenter - cameraPosition);
+
+    lod.Select(distance > radius ? radius * focalScale / distance : std::numeric_limits<float>::infinity());
+  }
+}
+
+void Scene::UpdateLevelsOfDetail(Camera& camera) { UpdateLevelsOfDetail(camera.GetPosition(), camera.GetProjection()); }
+
+void Scene::OnTagComponentConstruct(entt::registry& registry, entt::entity entity) { m_EntityIndex[registry.get<TagComponent>(entity).UUID] = entity; }
+
+void Scene::OnTagComponentDestroy(entt::registry& registry, entt::entity entity) {
+  auto it = m_EntityIndex.find(registry.get<TagComponent>(entity).UUID);
+  if (it != m_EntityIndex.end() && it->second == entity) m_EntityIndex.erase(it);
+}